@@ -5,6 +5,7 @@ onready var color_rect = $ColorRect
 const SPEED = SGFixed.ONE * 10
 
 var vector: SGFixedVector2
+var batch_sync := false
 
 func _ready() -> void:
 	color_rect.color = Color(randf(), randf(), randf(), 1.0)
@@ -29,8 +30,11 @@ func move_me() -> Array:
 	fixed_position.iadd(vector)
 	timings.append(OS.get_ticks_usec() - timing)
 	
+	# When using batch sync, Main calls SGPhysics2DServer.sync_all_dirty()
+	# once for all objects instead.
 	timing = OS.get_ticks_usec()
-	sync_to_physics_engine()
+	if not batch_sync:
+		sync_to_physics_engine()
 	timings.append(OS.get_ticks_usec() - timing)
 	
 	var viewport_size = get_viewport().size
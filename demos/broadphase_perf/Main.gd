@@ -2,6 +2,10 @@ extends Node2D
 
 const FixedObject = preload("res://demos/broadphase_perf/FixedObject.tscn")
 
+# Set to false to compare against calling sync_to_physics_engine() on each
+# object from its script.
+const BATCH_SYNC := true
+
 var avg_timings := {}
 var count := 0
 
@@ -11,12 +15,14 @@ func _ready() -> void:
 	avg_timings['query_physics'] = 0.0
 	avg_timings['change_position'] = 0.0
 	avg_timings['update_physics'] = 0.0
+	avg_timings['sync_all_dirty'] = 0.0
 	
 	var viewport_size = get_viewport().size
 	
 	# Create 100 objects.
 	for i in range(100):
 		var obj = FixedObject.instance()
+		obj.batch_sync = BATCH_SYNC
 		obj.fixed_position = SGFixed.vector2(
 			SGFixed.from_int(randi() % int(viewport_size.x)),
 			SGFixed.from_int(randi() % int(viewport_size.y)))
@@ -45,6 +51,8 @@ func _physics_process(delta: float) -> void:
 	var change_position_timings := []
 	var update_physics_timings := []
 	
+	SGPhysics2DServer.reset_process_info()
+	
 	var timings := []
 	for obj in get_children():
 		var timing = obj.move_me()
@@ -52,8 +60,19 @@ func _physics_process(delta: float) -> void:
 		change_position_timings.append(timing[1])
 		update_physics_timings.append(timing[2])
 	
+	var sync_all_dirty_timing = OS.get_ticks_usec()
+	if BATCH_SYNC:
+		SGPhysics2DServer.sync_all_dirty()
+	sync_all_dirty_timing = OS.get_ticks_usec() - sync_all_dirty_timing
+	
 	print (" ----- ")
 	print_timings(query_physics_timings, 'query_physics', '(1)')
 	print_timings(change_position_timings, 'change_position', '(2)')
 	print_timings(update_physics_timings, 'update_physics', '(3)')
+	print_timings([sync_all_dirty_timing], 'sync_all_dirty', '(3b)')
+	
+	var prefilter_tests = SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_PREFILTER_TESTS)
+	var prefilter_rejections = SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_PREFILTER_REJECTIONS)
+	if prefilter_tests > 0:
+		print ("(4) prefilter -- TESTS: %s  |  REJECTED: %s (%.02f%%)" % [prefilter_tests, prefilter_rejections, 100.0 * prefilter_rejections / prefilter_tests])
 	count += 1
@@ -5,6 +5,7 @@ onready var color_rect = $ColorRect
 const SPEED = SGFixed.ONE * 10
 
 var vector: SGFixedVector2
+var allocation_free := true
 
 func _ready() -> void:
 	color_rect.color = Color(randf(), randf(), randf(), 1.0)
@@ -13,7 +14,10 @@ func _ready() -> void:
 
 func move_me() -> int:
 	var timing = OS.get_ticks_usec()
-	fixed_position.iadd(vector)
+	if allocation_free:
+		fixed_position.iadd_xy(vector.x, vector.y)
+	else:
+		fixed_position = fixed_position.add(vector)
 	timing = OS.get_ticks_usec() - timing
 	
 	var viewport_size = get_viewport().size
@@ -3,6 +3,12 @@ extends Node2D
 const FloatObject = preload("res://demos/fixed_node_2d_perf/FloatObject.tscn")
 const FixedObject = preload("res://demos/fixed_node_2d_perf/FixedObject.tscn")
 
+# Set to false to compare against methods that allocate a new SGFixedVector2.
+const ALLOCATION_FREE := true
+# Nodes that never move, which shouldn't add to the cost of syncing the
+# float transforms.
+const IDLE_OBJECTS := 10000
+
 var min_timing := 1000000.0
 var max_timing := 0.0
 var avg_timing := 0.0
@@ -14,6 +20,7 @@ func _ready() -> void:
 	# Create 100 objects.
 	for i in range(100):
 		var obj = FixedObject.instance()
+		obj.allocation_free = ALLOCATION_FREE
 		add_child(obj)
 		obj.fixed_position = SGFixed.vector2(
 			SGFixed.from_int(randi() % int(viewport_size.x)),
@@ -24,10 +31,20 @@ func _ready() -> void:
 #		obj.position = Vector2(
 #			randi() % int(viewport_size.x),
 #			randi() % int(viewport_size.y))
+	
+	var idle_objects = Node.new()
+	idle_objects.name = "IdleObjects"
+	add_child(idle_objects)
+	for i in range(IDLE_OBJECTS):
+		idle_objects.add_child(SGFixedNode2D.new())
 
 func _physics_process(delta: float) -> void:
+	SGPhysics2DServer.reset_process_info()
+	
 	var timings := []
 	for obj in get_children():
+		if not obj.has_method("move_me"):
+			continue
 		var timing = obj.move_me()
 		timings.append(timing)
 	
@@ -42,4 +59,13 @@ func _physics_process(delta: float) -> void:
 	avg_timing = ((avg_timing * count) + avg) / float(count + 1)
 	count += 1
 	
-	print ("TOTAL: %s  |  AVG: %.02f  |  CULM. AVG: %.02f  |  MIN: %.02f  |  MAX: %.02f" % [sum, avg, avg_timing, min_timing, max_timing])
+	var allocations = SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_FIXED_VECTOR2_ALLOCATIONS)
+	
+	# Flush now, rather than waiting for it to happen automatically, so we
+	# can time it.
+	var sync_timing = OS.get_ticks_usec()
+	SGPhysics2DServer.flush_float_transforms()
+	sync_timing = OS.get_ticks_usec() - sync_timing
+	var syncs = SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_FLOAT_TRANSFORM_SYNCS)
+	
+	print ("TOTAL: %s  |  AVG: %.02f  |  CULM. AVG: %.02f  |  MIN: %.02f  |  MAX: %.02f  |  ALLOCATIONS: %s  |  FLOAT SYNC: %s (%s nodes)" % [sum, avg, avg_timing, min_timing, max_timing, allocations, sync_timing, syncs])
@@ -0,0 +1,95 @@
+extends Node2D
+
+const WORLD_COUNT := 64
+const BODIES_PER_WORLD := 300
+const RAYS_PER_WORLD := 64
+const SIZE := 1000
+const FRAMES_PER_THREAD_COUNT := 120
+
+var worlds := []
+var world_bodies := []
+
+# Each worker count is measured in turn, from stepping every world on the
+# calling thread, up to using every processor.
+var thread_counts := []
+var thread_count_index := 0
+var total_timing := 0
+var frame := 0
+var timings := []
+
+func _ready() -> void:
+	randomize()
+	
+	var thread_count := 0
+	while thread_count < OS.get_processor_count():
+		thread_counts.append(thread_count)
+		thread_count = thread_count * 2 + 1
+	if thread_counts[-1] != OS.get_processor_count() - 1:
+		thread_counts.append(OS.get_processor_count() - 1)
+	SGPhysics2DServer.worlds_set_thread_count(thread_counts[0])
+	
+	var ray_starts := []
+	var ray_cast_tos := []
+	for i in range(RAYS_PER_WORLD):
+		ray_starts.append(SGFixed.from_int(i * SIZE / RAYS_PER_WORLD))
+		ray_starts.append(0)
+		ray_cast_tos.append(0)
+		ray_cast_tos.append(SGFixed.from_int(SIZE))
+	
+	for i in range(WORLD_COUNT):
+		var world = SGPhysics2DServer.world_create()
+		var bodies := []
+		for j in range(BODIES_PER_WORLD):
+			var body = SGPhysics2DServer.body_create(SGPhysics2DServer.BODY_STATIC, world)
+			SGPhysics2DServer.collision_object_add_rectangle_shape(body, SGFixed.from_int(8), SGFixed.from_int(8))
+			bodies.append(body)
+		SGPhysics2DServer.world_set_ray_casts(world, ray_starts, ray_cast_tos)
+		worlds.append(world)
+		world_bodies.append(bodies)
+
+func _exit_tree() -> void:
+	SGPhysics2DServer.worlds_set_thread_count(-1)
+	for i in range(worlds.size()):
+		for body in world_bodies[i]:
+			SGPhysics2DServer.free_rid(body)
+		SGPhysics2DServer.free_rid(worlds[i])
+
+func queue_random_positions() -> void:
+	for i in range(worlds.size()):
+		var positions := []
+		for j in range(BODIES_PER_WORLD):
+			positions.append(SGFixed.from_int(randi() % SIZE))
+			positions.append(SGFixed.from_int(randi() % SIZE))
+		SGPhysics2DServer.world_queue_positions(worlds[i], world_bodies[i], positions)
+
+func print_results() -> void:
+	print (" ----- ")
+	print ("%s worlds, %s processors reported" % [WORLD_COUNT, OS.get_processor_count()])
+	print ("threads | avg usec | speedup")
+	for i in range(timings.size()):
+		# The calling thread steps worlds too, so it's counted.
+		print ("%7d | %8.0f | %.02f" % [thread_counts[i] + 1, timings[i], timings[0] / timings[i]])
+
+func _physics_process(delta: float) -> void:
+	if thread_count_index >= thread_counts.size():
+		return
+	
+	queue_random_positions()
+	var timing = OS.get_ticks_usec()
+	SGPhysics2DServer.worlds_step(worlds)
+	timing = OS.get_ticks_usec() - timing
+	
+	# The first frame with each count also starts the threads, so skip it.
+	if frame > 0:
+		total_timing += timing
+	frame += 1
+	
+	if frame > FRAMES_PER_THREAD_COUNT:
+		timings.append(total_timing / float(FRAMES_PER_THREAD_COUNT))
+		total_timing = 0
+		frame = 0
+		thread_count_index += 1
+		if thread_count_index < thread_counts.size():
+			SGPhysics2DServer.worlds_set_thread_count(thread_counts[thread_count_index])
+		else:
+			print_results()
@@ -1,6 +1,13 @@
 def can_build(env, platform):
     return True
 
+def get_opts(platform):
+    from SCons.Variables import BoolVariable
+
+    return [
+        BoolVariable("sg_fixed_legacy_math", "Use 64-bit intermediates for fixed-point multiplication and division", False),
+    ]
+
 def configure(env):
     pass
 
@@ -21,11 +28,15 @@ def get_doc_classes():
         'SGKinematicBody2D',
         'SGKinematicCollision2D',
         'SGRayCast2D',
+        'SGRayFan2D',
+        'SGTileCollisionGrid2D',
         'SGCollisionShape2D',
         'SGCollisionPolygon2D',
         'SGShape2D',
         'SGRectangleShape2D',
         'SGCircleShape2D',
         'SGYSort',
+        'SGWorld2D',
+        'SGPhysics2DServer',
     ]
 
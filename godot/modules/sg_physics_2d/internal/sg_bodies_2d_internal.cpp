@@ -26,13 +26,13 @@
 #include "sg_world_2d_internal.h"
 #include "sg_broadphase_2d_internal.h"
 
-void SGCollisionObject2DInternal::set_transform(const SGFixedTransform2DInternal &p_transform) {
+void SGCollisionObject2DInternal::set_transform(const SGFixedTransform2DInternal &p_transform, bool p_update_broadphase) {
 	transform = p_transform;
 	for (List<SGShape2DInternal *>::Element *E = shapes.front(); E; E = E->next()) {
 		E->get()->mark_global_xform_dirty();
 	}
 
-	if (broadphase) {
+	if (broadphase && p_update_broadphase) {
 		if (broadphase_element) {
 			broadphase->update_element(broadphase_element);
 		}
@@ -44,6 +44,7 @@ void SGCollisionObject2DInternal::set_transform(const SGFixedTransform2DInternal
 
 void SGCollisionObject2DInternal::add_shape(SGShape2DInternal *p_shape) {
 	p_shape->set_owner(this);
+	p_shape->index = next_shape_index++;
 	shapes.push_back(p_shape);
 
 	if (broadphase && broadphase_element) {
@@ -92,11 +93,59 @@ void SGCollisionObject2DInternal::remove_from_broadphase() {
 	}
 }
 
+void SGCollisionObject2DInternal::sort_by_id(SGCollisionObject2DInternal **p_objects, SGCollisionObject2DInternal **p_scratch, int p_count) {
+	if (p_count < 2) {
+		return;
+	}
+
+	// Ids are handed out in order starting from 1, so usually only the
+	// lowest byte or two are used, and there's no need to sort on the rest.
+	uint64_t id_bits = 0;
+	for (int i = 0; i < p_count; i++) {
+		id_bits |= p_objects[i]->id;
+	}
+
+	SGCollisionObject2DInternal **from = p_objects;
+	SGCollisionObject2DInternal **to = p_scratch;
+	int counts[256];
+
+	for (int shift = 0; shift < 64 && (id_bits >> shift) != 0; shift += 8) {
+		memset(counts, 0, sizeof(counts));
+		for (int i = 0; i < p_count; i++) {
+			counts[(from[i]->id >> shift) & 0xFF]++;
+		}
+
+		// If they all have the same value for this byte, there's nothing to do.
+		if (counts[(from[0]->id >> shift) & 0xFF] == p_count) {
+			continue;
+		}
+
+		int offset = 0;
+		for (int i = 0; i < 256; i++) {
+			int count = counts[i];
+			counts[i] = offset;
+			offset += count;
+		}
+
+		for (int i = 0; i < p_count; i++) {
+			to[counts[(from[i]->id >> shift) & 0xFF]++] = from[i];
+		}
+
+		SWAP(from, to);
+	}
+
+	if (from != p_objects) {
+		memcpy(p_objects, from, sizeof(SGCollisionObject2DInternal *) * p_count);
+	}
+}
+
 SGCollisionObject2DInternal::SGCollisionObject2DInternal(ObjectType p_type) {
 	object_type = p_type;
+	next_shape_index = 0;
 	broadphase = nullptr;
 	broadphase_element = nullptr;
 	data = nullptr;
+	id = 0;
 	collision_layer = 1;
 	collision_mask = 1;
 }
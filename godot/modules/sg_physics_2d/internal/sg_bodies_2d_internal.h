@@ -25,6 +25,7 @@
 #define SG_BODIES_2D_INTERNAL_H
 
 #include <core/vector.h>
+#include <core/rid.h>
 
 #include "sg_shapes_2d_internal.h"
 #include "sg_broadphase_2d_internal.h"
@@ -41,9 +42,12 @@ private:
 	ObjectType object_type;
 	SGFixedTransform2DInternal transform;
 	List<SGShape2DInternal *> shapes;
+	uint32_t next_shape_index;
 	SGBroadphase2DInternal *broadphase;
 	SGBroadphase2DInternal::Element *broadphase_element;
 	void *data;
+	RID rid;
+	uint64_t id;
 
 	uint32_t collision_layer;
 	uint32_t collision_mask;
@@ -52,7 +56,9 @@ public:
 	_FORCE_INLINE_ ObjectType get_object_type() const { return object_type; }
 
 	_FORCE_INLINE_ SGFixedTransform2DInternal get_transform() const { return transform; }
-	void set_transform(const SGFixedTransform2DInternal &p_transform);
+	// Skipping the broadphase update is only safe if it's updated again
+	// before the broadphase is next queried.
+	void set_transform(const SGFixedTransform2DInternal &p_transform, bool p_update_broadphase = true);
 
 	void add_shape(SGShape2DInternal *p_shape);
 	void remove_shape(SGShape2DInternal *p_shape);
@@ -69,6 +75,21 @@ public:
 	_FORCE_INLINE_ void set_data(void *p_data) { data = p_data; }
 	_FORCE_INLINE_ void *get_data() const { return data; }
 
+	// Objects created directly through SGPhysics2DServer have a RID, rather
+	// than a node in the data.
+	_FORCE_INLINE_ void set_rid(const RID &p_rid) { rid = p_rid; }
+	_FORCE_INLINE_ RID get_rid() const { return rid; }
+
+	// Used to put objects into a deterministic order, so it needs to be the
+	// same on every client.
+	_FORCE_INLINE_ void set_id(uint64_t p_id) { id = p_id; }
+	_FORCE_INLINE_ uint64_t get_id() const { return id; }
+
+	// Sorts by id using a radix sort. The scratch space must be big enough
+	// to hold p_count objects.
+	static void sort_by_id(SGCollisionObject2DInternal **p_objects, SGCollisionObject2DInternal **p_scratch, int p_count);
+	static bool compare_ids(SGCollisionObject2DInternal *p_a, SGCollisionObject2DInternal *p_b) { return p_a->id < p_b->id; }
+
 	_FORCE_INLINE_ void set_collision_layer(uint32_t p_collision_layer) { collision_layer = p_collision_layer; }
 	_FORCE_INLINE_ uint32_t get_collision_layer() const { return collision_layer; }
 
@@ -96,6 +117,7 @@ public:
 	enum BodyType {
 		BODY_STATIC,
 		BODY_KINEMATIC,
+		BODY_TILE_GRID,
 	};
 
 protected:
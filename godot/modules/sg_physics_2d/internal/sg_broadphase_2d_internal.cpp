@@ -25,6 +25,146 @@
 
 #include "sg_bodies_2d_internal.h"
 
+#if defined(__x86_64__) && defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+#define SG_BROADPHASE_SIMD_ENABLED
+#include <immintrin.h>
+#endif
+
+// Checks which of the elements in a cell intersect the query bounds (given
+// as min x, min y, max x and max y), and sets r_hits[i] to 1 for each one
+// that does and 0 for each one that doesn't.
+typedef void (*SGBroadphaseIntersectKernel)(const SGBroadphase2DInternal::Cell *p_cell, const int64_t *p_query, uint8_t *r_hits);
+
+// This must give exactly the same result as SGFixedRect2Internal::intersects().
+static void _intersect_scalar(const int64_t *p_min_x, const int64_t *p_min_y, const int64_t *p_max_x, const int64_t *p_max_y, int p_from, int p_to, const int64_t *p_query, uint8_t *r_hits) {
+	for (int i = p_from; i < p_to; i++) {
+		r_hits[i] = (p_query[0] <= p_max_x[i]) & (p_min_x[i] <= p_query[2]) &
+			(p_query[1] <= p_max_y[i]) & (p_min_y[i] <= p_query[3]);
+	}
+}
+
+static void _intersect_kernel_scalar(const SGBroadphase2DInternal::Cell *p_cell, const int64_t *p_query, uint8_t *r_hits) {
+	_intersect_scalar(p_cell->min_x.ptr(), p_cell->min_y.ptr(), p_cell->max_x.ptr(), p_cell->max_y.ptr(), 0, p_cell->elements.size(), p_query, r_hits);
+}
+
+#ifdef SG_BROADPHASE_SIMD_ENABLED
+
+__attribute__((target("avx2")))
+static void _intersect_kernel_avx2(const SGBroadphase2DInternal::Cell *p_cell, const int64_t *p_query, uint8_t *r_hits) {
+	const int64_t *min_x = p_cell->min_x.ptr();
+	const int64_t *min_y = p_cell->min_y.ptr();
+	const int64_t *max_x = p_cell->max_x.ptr();
+	const int64_t *max_y = p_cell->max_y.ptr();
+	int count = p_cell->elements.size();
+
+	const __m256i query_min_x = _mm256_set1_epi64x(p_query[0]);
+	const __m256i query_min_y = _mm256_set1_epi64x(p_query[1]);
+	const __m256i query_max_x = _mm256_set1_epi64x(p_query[2]);
+	const __m256i query_max_y = _mm256_set1_epi64x(p_query[3]);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m256i miss = _mm256_or_si256(
+			_mm256_or_si256(
+				_mm256_cmpgt_epi64(query_min_x, _mm256_loadu_si256((const __m256i *)(max_x + i))),
+				_mm256_cmpgt_epi64(_mm256_loadu_si256((const __m256i *)(min_x + i)), query_max_x)),
+			_mm256_or_si256(
+				_mm256_cmpgt_epi64(query_min_y, _mm256_loadu_si256((const __m256i *)(max_y + i))),
+				_mm256_cmpgt_epi64(_mm256_loadu_si256((const __m256i *)(min_y + i)), query_max_y)));
+		int mask = _mm256_movemask_pd(_mm256_castsi256_pd(miss));
+		r_hits[i] = !(mask & 1);
+		r_hits[i + 1] = !(mask & 2);
+		r_hits[i + 2] = !(mask & 4);
+		r_hits[i + 3] = !(mask & 8);
+	}
+
+	_intersect_scalar(min_x, min_y, max_x, max_y, i, count, p_query, r_hits);
+}
+
+#endif
+
+// There's no SSE4.2 kernel: with only two 64-bit lanes per compare, it was
+// slower than the scalar loop, so CPUs without AVX2 use that instead.
+static SGBroadphaseIntersectKernel _select_intersect_kernel() {
+#ifdef SG_BROADPHASE_SIMD_ENABLED
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return _intersect_kernel_avx2;
+	}
+#endif
+	return _intersect_kernel_scalar;
+}
+
+static const SGBroadphaseIntersectKernel intersect_kernel = _select_intersect_kernel();
+
+void SGBroadphase2DInternal::Cell::add_element(SGBroadphase2DInternal::Element *p_element) {
+	SGFixedVector2Internal min = p_element->bounds.get_min();
+	SGFixedVector2Internal max = p_element->bounds.get_max();
+
+	elements.push_back(p_element);
+	min_x.push_back(min.x.value);
+	min_y.push_back(min.y.value);
+	max_x.push_back(max.x.value);
+	max_y.push_back(max.y.value);
+}
+
+void SGBroadphase2DInternal::Cell::remove_element(SGBroadphase2DInternal::Element *p_element) {
+	// Removing (rather than swapping with the last element) keeps the order
+	// that results are found in the same as the order elements were added.
+	int index = elements.find(p_element);
+	if (index == -1) {
+		return;
+	}
+
+	elements.remove(index);
+	min_x.remove(index);
+	min_y.remove(index);
+	max_x.remove(index);
+	max_y.remove(index);
+}
+
+void SGBroadphase2DInternal::Cell::update_element(SGBroadphase2DInternal::Element *p_element) {
+	int index = elements.find(p_element);
+	if (index == -1) {
+		return;
+	}
+
+	SGFixedVector2Internal min = p_element->bounds.get_min();
+	SGFixedVector2Internal max = p_element->bounds.get_max();
+
+	min_x.write[index] = min.x.value;
+	min_y.write[index] = min.y.value;
+	max_x.write[index] = max.x.value;
+	max_y.write[index] = max.y.value;
+}
+
+void SGBroadphase2DInternal::Cell::remove_batch_removing_elements() {
+	// Compact all the arrays in a single pass, keeping the order of the
+	// remaining elements, rather than removing elements one at a time.
+	int count = elements.size();
+	int write = 0;
+	for (int read = 0; read < count; read++) {
+		if (elements[read]->batch_removing) {
+			continue;
+		}
+		if (write != read) {
+			elements.write[write] = elements[read];
+			min_x.write[write] = min_x[read];
+			min_y.write[write] = min_y[read];
+			max_x.write[write] = max_x[read];
+			max_y.write[write] = max_y[read];
+		}
+		write++;
+	}
+
+	elements.resize(write);
+	min_x.resize(write);
+	min_y.resize(write);
+	max_x.resize(write);
+	max_y.resize(write);
+	batch_removing = false;
+}
+
 void SGBroadphase2DInternal::_add_element_to_cells(SGBroadphase2DInternal::Element *p_element) {
 	HashKey from = p_element->from;
 	HashKey to = p_element->to;
@@ -43,7 +183,7 @@ void SGBroadphase2DInternal::_add_element_to_cells(SGBroadphase2DInternal::Eleme
 				cell_element = cells.insert(key, cell);
 			}
 
-			cell->elements.push_back(p_element);
+			cell->add_element(p_element);
 		}
 	}
 }
@@ -62,7 +202,7 @@ void SGBroadphase2DInternal::_remove_element_from_cells(SGBroadphase2DInternal::
 			}
 
 			Cell *cell = cell_element->get();
-			cell->elements.erase(p_element);
+			cell->remove_element(p_element);
 
 			if (cell->elements.size() == 0) {
 				cells.erase(key);
@@ -72,6 +212,20 @@ void SGBroadphase2DInternal::_remove_element_from_cells(SGBroadphase2DInternal::
 	}
 }
 
+void SGBroadphase2DInternal::_update_element_in_cells(SGBroadphase2DInternal::Element *p_element) {
+	HashKey from = p_element->from;
+	HashKey to = p_element->to;
+
+	for (int32_t x = from.x; x <= to.x; x++) {
+		for (int32_t y = from.y; y <= to.y; y++) {
+			Map<HashKey, Cell *>::Element *cell_element = cells.find(HashKey(x, y));
+			if (cell_element) {
+				cell_element->get()->update_element(p_element);
+			}
+		}
+	}
+}
+
 void SGBroadphase2DInternal::_clear_cells() {
 	for (Map<HashKey, Cell *>::Element *E = cells.front(); E; E = E->next()) {
 		memdelete(E->get());
@@ -84,6 +238,16 @@ SGBroadphase2DInternal::Element *SGBroadphase2DInternal::create_element(SGCollis
 	elements.push_back(element);
 
 	element->object = p_object;
+
+	if (batching) {
+		BatchUpdate update;
+		update.element = element;
+		update.created = true;
+		batch_updates.push_back(update);
+		element->batch_pending = true;
+		return element;
+	}
+
 	element->bounds = p_object->get_bounds();
 
 	SGFixedVector2Internal min = element->bounds.get_min();
@@ -102,6 +266,17 @@ SGBroadphase2DInternal::Element *SGBroadphase2DInternal::create_element(SGCollis
 }
 
 void SGBroadphase2DInternal::update_element(SGBroadphase2DInternal::Element *p_element) {
+	if (batching) {
+		if (!p_element->batch_pending) {
+			BatchUpdate update;
+			update.element = p_element;
+			update.created = false;
+			batch_updates.push_back(update);
+			p_element->batch_pending = true;
+		}
+		return;
+	}
+
 	p_element->bounds = p_element->object->get_bounds();
 
 	SGFixedVector2Internal min = p_element->bounds.get_min();
@@ -116,6 +291,7 @@ void SGBroadphase2DInternal::update_element(SGBroadphase2DInternal::Element *p_e
 
 
 	if (p_element->from == from && p_element->to == to) {
+		_update_element_in_cells(p_element);
 		return;
 	}
 
@@ -128,11 +304,93 @@ void SGBroadphase2DInternal::update_element(SGBroadphase2DInternal::Element *p_e
 }
 
 void SGBroadphase2DInternal::delete_element(SGBroadphase2DInternal::Element *p_element) {
-	_remove_element_from_cells(p_element);
+	bool in_cells = true;
+	if (p_element->batch_pending) {
+		for (int i = 0; i < batch_updates.size(); i++) {
+			if (batch_updates[i].element == p_element) {
+				in_cells = !batch_updates[i].created;
+				batch_updates.remove(i);
+				break;
+			}
+		}
+	}
+
+	if (in_cells) {
+		_remove_element_from_cells(p_element);
+	}
 	elements.erase(p_element);
 	memdelete(p_element);
 }
 
+void SGBroadphase2DInternal::begin_batch() {
+	batching = true;
+}
+
+void SGBroadphase2DInternal::end_batch() {
+	batching = false;
+
+	// This gives the same cell contents (including their order) as updating
+	// each element in turn: elements that stay in the same cells keep their
+	// place, and the others are removed and then appended in batch order.
+	Vector<HashKey> removing_cells;
+	Vector<SGBroadphase2DInternal::Element *> adding;
+
+	for (int i = 0; i < batch_updates.size(); i++) {
+		SGBroadphase2DInternal::Element *element = batch_updates[i].element;
+		element->batch_pending = false;
+		element->bounds = element->object->get_bounds();
+
+		SGFixedVector2Internal min = element->bounds.get_min();
+		SGFixedVector2Internal max = element->bounds.get_max();
+
+		HashKey from(
+			min.x.to_int() / cell_size,
+			min.y.to_int() / cell_size);
+		HashKey to(
+			max.x.to_int() / cell_size,
+			max.y.to_int() / cell_size);
+
+		if (!batch_updates[i].created) {
+			if (element->from == from && element->to == to) {
+				_update_element_in_cells(element);
+				continue;
+			}
+
+			element->batch_removing = true;
+			for (int32_t x = element->from.x; x <= element->to.x; x++) {
+				for (int32_t y = element->from.y; y <= element->to.y; y++) {
+					HashKey key(x, y);
+					Map<HashKey, Cell *>::Element *cell_element = cells.find(key);
+					if (cell_element && !cell_element->get()->batch_removing) {
+						cell_element->get()->batch_removing = true;
+						removing_cells.push_back(key);
+					}
+				}
+			}
+		}
+
+		element->from = from;
+		element->to = to;
+		adding.push_back(element);
+	}
+	batch_updates.clear();
+
+	for (int i = 0; i < removing_cells.size(); i++) {
+		Map<HashKey, Cell *>::Element *cell_element = cells.find(removing_cells[i]);
+		Cell *cell = cell_element->get();
+		cell->remove_batch_removing_elements();
+		if (cell->elements.size() == 0) {
+			cells.erase(removing_cells[i]);
+			memdelete(cell);
+		}
+	}
+
+	for (int i = 0; i < adding.size(); i++) {
+		adding[i]->batch_removing = false;
+		_add_element_to_cells(adding[i]);
+	}
+}
+
 void SGBroadphase2DInternal::find_nearby(const SGFixedRect2Internal &p_bounds, SGResultHandlerInternal *p_result_handler, int p_type) const {
 	SGFixedVector2Internal min = p_bounds.get_min();
 	SGFixedVector2Internal max = p_bounds.get_max();
@@ -145,6 +403,7 @@ void SGBroadphase2DInternal::find_nearby(const SGFixedRect2Internal &p_bounds, S
 		max.y.to_int() / cell_size);
 
 	uint64_t query_id = (++current_query_id);
+	const int64_t query[4] = { min.x.value, min.y.value, max.x.value, max.y.value };
 
 	for (int32_t x = from.x; x <= to.x; x++) {
 		for (int32_t y = from.y; y <= to.y; y++) {
@@ -157,12 +416,23 @@ void SGBroadphase2DInternal::find_nearby(const SGFixedRect2Internal &p_bounds, S
 			}
 
 			cell = cell_element->get();
-			for (List<SGBroadphase2DInternal::Element *>::Element *E = cell->elements.front(); E; E = E->next()) {
-				SGBroadphase2DInternal::Element *element = E->get();
+			int count = cell->elements.size();
+			if (query_hits.size() < count) {
+				query_hits.resize(count);
+			}
+			uint8_t *hits = query_hits.ptrw();
+			intersect_kernel(cell, query, hits);
+
+			SGBroadphase2DInternal::Element *const *cell_elements = cell->elements.ptr();
+			for (int i = 0; i < count; i++) {
+				if (!hits[i]) {
+					continue;
+				}
+				SGBroadphase2DInternal::Element *element = cell_elements[i];
 				if (element->query_id == query_id) {
 					continue;
 				}
-				if ((element->object->get_object_type() & p_type) && p_bounds.intersects(element->bounds)) {
+				if (element->object->get_object_type() & p_type) {
 					element->query_id = query_id;
 					p_result_handler->handle_result(element->object);
 				}
@@ -171,6 +441,20 @@ void SGBroadphase2DInternal::find_nearby(const SGFixedRect2Internal &p_bounds, S
 	}
 }
 
+int SGBroadphase2DInternal::get_cell_count(const SGFixedRect2Internal &p_bounds) const {
+	SGFixedVector2Internal min = p_bounds.get_min();
+	SGFixedVector2Internal max = p_bounds.get_max();
+
+	HashKey from(
+		min.x.to_int() / cell_size,
+		min.y.to_int() / cell_size);
+	HashKey to(
+		max.x.to_int() / cell_size,
+		max.y.to_int() / cell_size);
+
+	return (to.x - from.x + 1) * (to.y - from.y + 1);
+}
+
 void SGBroadphase2DInternal::set_cell_size(int p_cell_size) {
 	if (cell_size != p_cell_size) {
 		cell_size = p_cell_size;
@@ -197,6 +481,7 @@ void SGBroadphase2DInternal::set_cell_size(int p_cell_size) {
 SGBroadphase2DInternal::SGBroadphase2DInternal(int p_cell_size) {
 	cell_size = p_cell_size;
 	current_query_id = 0;
+	batching = false;
 }
 
 SGBroadphase2DInternal::~SGBroadphase2DInternal() {
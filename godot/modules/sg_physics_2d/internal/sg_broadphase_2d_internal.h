@@ -26,6 +26,7 @@
 
 #include <core/list.h>
 #include <core/map.h>
+#include <core/vector.h>
 
 #include "sg_fixed_rect2_internal.h"
 #include "sg_result_handler_internal.h"
@@ -65,15 +66,37 @@ public:
 		HashKey from;
 		HashKey to;
 		uint64_t query_id;
+		bool batch_pending;
+		bool batch_removing;
 
 		_FORCE_INLINE_ Element() {
 			object = nullptr;
 			query_id = 0;
+			batch_pending = false;
+			batch_removing = false;
 		}
 	};
 
 	struct Cell {
-		List<Element *> elements;
+		Vector<Element *> elements;
+
+		// A packed copy of the elements' bounds, so that they can be tested
+		// against a query in batches.
+		Vector<int64_t> min_x;
+		Vector<int64_t> min_y;
+		Vector<int64_t> max_x;
+		Vector<int64_t> max_y;
+
+		bool batch_removing;
+
+		void add_element(Element *p_element);
+		void remove_element(Element *p_element);
+		void update_element(Element *p_element);
+		void remove_batch_removing_elements();
+
+		_FORCE_INLINE_ Cell() {
+			batch_removing = false;
+		}
 	};
 
 private:
@@ -81,9 +104,18 @@ private:
 	Map<HashKey, Cell *> cells;
 	int cell_size;
 	mutable uint64_t current_query_id;
+	mutable Vector<uint8_t> query_hits;
+
+	struct BatchUpdate {
+		Element *element;
+		bool created;
+	};
+	bool batching;
+	Vector<BatchUpdate> batch_updates;
 
 	void _add_element_to_cells(Element *p_element);
 	void _remove_element_from_cells(Element *p_element);
+	void _update_element_in_cells(Element *p_element);
 	void _clear_cells();
 
 public:
@@ -91,9 +123,19 @@ public:
 	void update_element(Element *p_element);
 	void delete_element(Element *p_element);
 
+	// Between these calls, creating or updating elements only records them,
+	// and the cells are updated all at once at the end. The broadphase
+	// mustn't be queried until the batch has ended.
+	void begin_batch();
+	void end_batch();
+
 	// p_type is really SGCollisionObject2DInternal::ObjectType, but I couldn't work out the circulate dependencies.
 	void find_nearby(const SGFixedRect2Internal &p_bounds, SGResultHandlerInternal *p_result_handler, int p_type = 3) const;
 
+	// Returns the number of cells an element with the given bounds would be
+	// added to.
+	int get_cell_count(const SGFixedRect2Internal &p_bounds) const;
+
 	void set_cell_size(int p_cell_size);
 
 	SGBroadphase2DInternal(int p_cell_size);
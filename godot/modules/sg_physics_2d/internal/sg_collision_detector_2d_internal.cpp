@@ -36,6 +36,45 @@ bool SGCollisionDetector2DInternal::AABB_overlaps_AABB(const SGFixedRect2Interna
 		   (min_two.y <= max_one.y) && (min_one.y <= max_two.y);
 }
 
+bool SGCollisionDetector2DInternal::bounding_circles_overlap(const SGShape2DInternal &shape1, const SGShape2DInternal &shape2) {
+	using ShapeType = SGShape2DInternal::ShapeType;
+
+	fixed radius1 = shape1.get_global_bounding_radius();
+	fixed radius2 = shape2.get_global_bounding_radius();
+
+	// Circles get tested in the local space of rectangles, which is only
+	// equivalent if we account for the rectangle's non-uniform scale.
+	if (shape1.get_shape_type() == ShapeType::SHAPE_CIRCLE && shape2.get_shape_type() == ShapeType::SHAPE_RECTANGLE) {
+		fixed stretch = shape2.get_global_bounding_stretch();
+		if (stretch < fixed::ZERO) {
+			return true;
+		}
+		radius1 = radius1 * stretch;
+	}
+	else if (shape1.get_shape_type() == ShapeType::SHAPE_RECTANGLE && shape2.get_shape_type() == ShapeType::SHAPE_CIRCLE) {
+		fixed stretch = shape1.get_global_bounding_stretch();
+		if (stretch < fixed::ZERO) {
+			return true;
+		}
+		radius2 = radius2 * stretch;
+	}
+
+	fixed combined_radius = radius1 + radius2;
+	// Squaring anything larger would overflow, so leave it to the narrowphase.
+	if (combined_radius.value > INT32_MAX) {
+		return true;
+	}
+
+	SGFixedVector2Internal line = shape2.get_global_transform().get_origin() - shape1.get_global_transform().get_origin();
+	fixed dx = line.x.abs();
+	fixed dy = line.y.abs();
+	if (dx > combined_radius || dy > combined_radius) {
+		return false;
+	}
+
+	return (dx * dx + dy * dy) <= combined_radius * combined_radius;
+}
+
 Interval SGCollisionDetector2DInternal::get_interval(const SGShape2DInternal &shape, const SGFixedVector2Internal &axis) {
 	Interval result;
 
@@ -84,7 +123,7 @@ bool SGCollisionDetector2DInternal::overlaps_on_axis(const SGShape2DInternal &sh
 	return false;
 }
 
-bool SGCollisionDetector2DInternal::sat_test(const SGShape2DInternal &shape1, const SGShape2DInternal &shape2, const Vector<SGFixedVector2Internal> &axes, SGFixedVector2Internal &best_separation_vector) {
+bool SGCollisionDetector2DInternal::sat_test(const SGShape2DInternal &shape1, const SGShape2DInternal &shape2, const Vector<SGFixedVector2Internal> &axes, SGFixedVector2Internal &best_separation_vector, int *p_separating_axis) {
 	fixed separation_component;
 
 	for (int i = 0; i < axes.size(); i++) {
@@ -96,6 +135,9 @@ bool SGCollisionDetector2DInternal::sat_test(const SGShape2DInternal &shape1, co
 		}
 		else {
 			// Axis of separation found! They don't overlap.
+			if (p_separating_axis) {
+				*p_separating_axis = i;
+			}
 			return false;
 		}
 	}
@@ -104,14 +146,45 @@ bool SGCollisionDetector2DInternal::sat_test(const SGShape2DInternal &shape1, co
 	return true;
 }
 
-bool SGCollisionDetector2DInternal::Rectangle_overlaps_Rectangle(const SGRectangle2DInternal &rectangle1, const SGRectangle2DInternal &rectangle2, OverlapInfo *p_info) {
+bool SGCollisionDetector2DInternal::is_separating_axis(const SGShape2DInternal &shape1, const SGShape2DInternal &shape2, const Vector<SGFixedVector2Internal> &axes1, const Vector<SGFixedVector2Internal> &axes2, int axis) {
+	fixed separation_component;
+
+	if (axis < 0) {
+		return false;
+	}
+	if (axis < axes1.size()) {
+		return !overlaps_on_axis(shape1, shape2, axes1[axis], separation_component);
+	}
+	axis -= axes1.size();
+	if (axis < axes2.size()) {
+		return !overlaps_on_axis(shape1, shape2, axes2[axis], separation_component);
+	}
+
+	return false;
+}
+
+bool SGCollisionDetector2DInternal::Rectangle_overlaps_Rectangle(const SGRectangle2DInternal &rectangle1, const SGRectangle2DInternal &rectangle2, OverlapInfo *p_info, int *p_axis_hint) {
 	SGFixedVector2Internal best_separation_vector;
+	Vector<SGFixedVector2Internal> axes1 = rectangle1.get_global_axes();
+	Vector<SGFixedVector2Internal> axes2 = rectangle2.get_global_axes();
 
-	if (!sat_test(rectangle1, rectangle2, rectangle1.get_global_axes(), best_separation_vector)) {
+	if (p_axis_hint && is_separating_axis(rectangle1, rectangle2, axes1, axes2, *p_axis_hint)) {
 		return false;
 	}
 
-	if (!sat_test(rectangle1, rectangle2, rectangle2.get_global_axes(), best_separation_vector)) {
+	int separating_axis;
+
+	if (!sat_test(rectangle1, rectangle2, axes1, best_separation_vector, &separating_axis)) {
+		if (p_axis_hint) {
+			*p_axis_hint = separating_axis;
+		}
+		return false;
+	}
+
+	if (!sat_test(rectangle1, rectangle2, axes2, best_separation_vector, &separating_axis)) {
+		if (p_axis_hint) {
+			*p_axis_hint = axes1.size() + separating_axis;
+		}
 		return false;
 	}
 
@@ -210,7 +283,7 @@ bool SGCollisionDetector2DInternal::Circle_overlaps_Rectangle(const SGCircle2DIn
 	return overlapping;
 }
 
-bool SGCollisionDetector2DInternal::Polygon_overlaps_Polygon(const SGPolygon2DInternal &polygon1, const SGPolygon2DInternal &polygon2, OverlapInfo *p_info) {
+bool SGCollisionDetector2DInternal::Polygon_overlaps_Polygon(const SGPolygon2DInternal &polygon1, const SGPolygon2DInternal &polygon2, OverlapInfo *p_info, int *p_axis_hint) {
 	if (polygon1.get_points().size() < 3) {
 		return false;
 	}
@@ -219,12 +292,26 @@ bool SGCollisionDetector2DInternal::Polygon_overlaps_Polygon(const SGPolygon2DIn
 	}
 
 	SGFixedVector2Internal best_separation_vector;
+	Vector<SGFixedVector2Internal> axes1 = polygon1.get_global_axes();
+	Vector<SGFixedVector2Internal> axes2 = polygon2.get_global_axes();
 
-	if (!sat_test(polygon1, polygon2, polygon1.get_global_axes(), best_separation_vector)) {
+	if (p_axis_hint && is_separating_axis(polygon1, polygon2, axes1, axes2, *p_axis_hint)) {
 		return false;
 	}
 
-	if (!sat_test(polygon1, polygon2, polygon2.get_global_axes(), best_separation_vector)) {
+	int separating_axis;
+
+	if (!sat_test(polygon1, polygon2, axes1, best_separation_vector, &separating_axis)) {
+		if (p_axis_hint) {
+			*p_axis_hint = separating_axis;
+		}
+		return false;
+	}
+
+	if (!sat_test(polygon1, polygon2, axes2, best_separation_vector, &separating_axis)) {
+		if (p_axis_hint) {
+			*p_axis_hint = axes1.size() + separating_axis;
+		}
 		return false;
 	}
 
@@ -235,15 +322,22 @@ bool SGCollisionDetector2DInternal::Polygon_overlaps_Polygon(const SGPolygon2DIn
 	return true;
 }
 
-bool SGCollisionDetector2DInternal::Polygon_overlaps_Circle(const SGPolygon2DInternal &polygon, const SGCircle2DInternal &circle, OverlapInfo *p_info) {
+bool SGCollisionDetector2DInternal::Polygon_overlaps_Circle(const SGPolygon2DInternal &polygon, const SGCircle2DInternal &circle, OverlapInfo *p_info, int *p_axis_hint) {
 	if (polygon.get_points().size() < 3) {
 		return false;
 	}
 
 	SGFixedVector2Internal best_separation_vector;
+	Vector<SGFixedVector2Internal> axes = polygon.get_global_axes();
+
+	// The circle's axis depends on its position, so only the polygon's axes
+	// can be hinted.
+	if (p_axis_hint && is_separating_axis(polygon, circle, axes, Vector<SGFixedVector2Internal>(), *p_axis_hint)) {
+		return false;
+	}
 
 	// First, we see if the circle has any seperation from the polygon's axes.
-	if (!sat_test(polygon, circle, polygon.get_global_axes(), best_separation_vector)) {
+	if (!sat_test(polygon, circle, axes, best_separation_vector, p_axis_hint)) {
 		return false;
 	}
 
@@ -266,6 +360,9 @@ bool SGCollisionDetector2DInternal::Polygon_overlaps_Circle(const SGPolygon2DInt
 	Vector<SGFixedVector2Internal> circle_axes;
 	circle_axes.push_back((ct.get_origin() - closest_vertex).normalized());
 	if (!sat_test(polygon, circle, circle_axes, best_separation_vector)) {
+		if (p_axis_hint) {
+			*p_axis_hint = -1;
+		}
 		return false;
 	}
 
@@ -276,18 +373,32 @@ bool SGCollisionDetector2DInternal::Polygon_overlaps_Circle(const SGPolygon2DInt
 	return true;
 }
 
-bool SGCollisionDetector2DInternal::Polygon_overlaps_Rectangle(const SGPolygon2DInternal &polygon, const SGRectangle2DInternal &rectangle, OverlapInfo *p_info) {
+bool SGCollisionDetector2DInternal::Polygon_overlaps_Rectangle(const SGPolygon2DInternal &polygon, const SGRectangle2DInternal &rectangle, OverlapInfo *p_info, int *p_axis_hint) {
 	if (polygon.get_points().size() < 3) {
 		return false;
 	}
 	
 	SGFixedVector2Internal best_separation_vector;
+	Vector<SGFixedVector2Internal> axes1 = polygon.get_global_axes();
+	Vector<SGFixedVector2Internal> axes2 = rectangle.get_global_axes();
 
-	if (!sat_test(polygon, rectangle, polygon.get_global_axes(), best_separation_vector)) {
+	if (p_axis_hint && is_separating_axis(polygon, rectangle, axes1, axes2, *p_axis_hint)) {
 		return false;
 	}
 
-	if (!sat_test(polygon, rectangle, rectangle.get_global_axes(), best_separation_vector)) {
+	int separating_axis;
+
+	if (!sat_test(polygon, rectangle, axes1, best_separation_vector, &separating_axis)) {
+		if (p_axis_hint) {
+			*p_axis_hint = separating_axis;
+		}
+		return false;
+	}
+
+	if (!sat_test(polygon, rectangle, axes2, best_separation_vector, &separating_axis)) {
+		if (p_axis_hint) {
+			*p_axis_hint = axes1.size() + separating_axis;
+		}
 		return false;
 	}
 
@@ -298,6 +409,270 @@ bool SGCollisionDetector2DInternal::Polygon_overlaps_Rectangle(const SGPolygon2D
 	return true;
 }
 
+// Narrows [r_enter, r_exit] to the fractions of the motion during which the
+// intervals overlap (touching counts, like in overlaps_on_axis()).
+static bool sweep_intervals(const Interval &i1, const Interval &i2, fixed speed, fixed &r_enter, fixed &r_exit) {
+	// They overlap while gap_min <= speed * t <= gap_max.
+	fixed gap_min = i2.min - i1.max;
+	fixed gap_max = i2.max - i1.min;
+
+	if (speed == fixed::ZERO) {
+		return gap_min <= fixed::ZERO && gap_max >= fixed::ZERO;
+	}
+	if (speed < fixed::ZERO) {
+		fixed tmp = gap_min;
+		gap_min = -gap_max;
+		gap_max = -tmp;
+		speed = -speed;
+	}
+
+	if (gap_max < fixed::ZERO || gap_min > speed) {
+		return false;
+	}
+
+	// Only divide when the result is between 0 and 1, so it can't overflow.
+	if (gap_min > fixed::ZERO) {
+		fixed enter = gap_min / speed;
+		if (enter > r_enter) {
+			r_enter = enter;
+		}
+	}
+	if (gap_max < speed) {
+		fixed exit = gap_max / speed;
+		if (exit < r_exit) {
+			r_exit = exit;
+		}
+	}
+
+	return r_enter <= r_exit;
+}
+
+bool SGCollisionDetector2DInternal::Polygon_time_of_impact(const SGShape2DInternal &shape1, const SGShape2DInternal &shape2, const SGFixedVector2Internal &motion, fixed &r_time, ImpactInfo *p_info) {
+	Vector<SGFixedVector2Internal> axes1 = shape1.get_global_axes();
+	Vector<SGFixedVector2Internal> axes2 = shape2.get_global_axes();
+
+	fixed enter = fixed::ZERO;
+	fixed exit = fixed::ONE;
+
+	// The axis we entered on last is the one we hit, using the same indexes
+	// as axis hints.
+	int enter_axis = -1;
+	SGFixedVector2Internal enter_normal;
+
+	for (int i = 0; i < axes1.size(); i++) {
+		fixed speed = axes1[i].dot(motion);
+		fixed previous_enter = enter;
+		if (!sweep_intervals(get_interval(shape1, axes1[i]), get_interval(shape2, axes1[i]), speed, enter, exit)) {
+			return false;
+		}
+		if (enter > previous_enter) {
+			enter_axis = i;
+			enter_normal = speed > fixed::ZERO ? -axes1[i] : axes1[i];
+		}
+	}
+	for (int i = 0; i < axes2.size(); i++) {
+		fixed speed = axes2[i].dot(motion);
+		fixed previous_enter = enter;
+		if (!sweep_intervals(get_interval(shape1, axes2[i]), get_interval(shape2, axes2[i]), speed, enter, exit)) {
+			return false;
+		}
+		if (enter > previous_enter) {
+			enter_axis = axes1.size() + i;
+			enter_normal = speed > fixed::ZERO ? -axes2[i] : axes2[i];
+		}
+	}
+
+	r_time = enter;
+
+	if (p_info) {
+		if (enter_axis == -1) {
+			// We were already touching, so there's no telling which way we hit.
+			p_info->normal = SGFixedVector2Internal::ZERO;
+			p_info->point = shape1.get_global_transform().get_origin();
+		}
+		else if (enter_axis < axes1.size()) {
+			// One of shape2's vertices hit a face of shape1.
+			Vector<SGFixedVector2Internal> verts = shape2.get_global_vertices();
+			p_info->point = verts[0];
+			for (int i = 1; i < verts.size(); i++) {
+				if (verts[i].dot(enter_normal) > p_info->point.dot(enter_normal)) {
+					p_info->point = verts[i];
+				}
+			}
+		}
+		else {
+			// One of shape1's vertices hit a face of shape2.
+			Vector<SGFixedVector2Internal> verts = shape1.get_global_vertices();
+			p_info->point = verts[0];
+			for (int i = 1; i < verts.size(); i++) {
+				if (verts[i].dot(enter_normal) < p_info->point.dot(enter_normal)) {
+					p_info->point = verts[i];
+				}
+			}
+			p_info->point += motion * enter;
+		}
+		p_info->normal = enter_normal;
+	}
+
+	return true;
+}
+
+#ifdef SG_FIXED_WIDE_MATH
+// Returns the integer square root (rounded down) of num.
+//
+// The estimate from sg_sqrt_64() on the top bits is rounded up, so it's at
+// least the real square root, and Newton's method then only steps down.
+static uint64_t sg_sqrt_128(unsigned __int128 num) {
+	if (num < (((unsigned __int128)1) << 62)) {
+		return (uint64_t)sg_sqrt_64((int64_t)num);
+	}
+
+	// Use an even shift, so it can be halved for the square root.
+	int shift = 0;
+	while ((num >> shift) >= (((unsigned __int128)1) << 62)) {
+		shift += 2;
+	}
+	unsigned __int128 res = ((unsigned __int128)sg_sqrt_64((int64_t)(num >> shift)) + 1) << (shift >> 1);
+
+	while (true) {
+		unsigned __int128 next = (res + num / res) >> 1;
+		if (next >= res) {
+			break;
+		}
+		res = next;
+	}
+
+	return (uint64_t)res;
+}
+#endif
+
+// Finds the fraction of the motion at which a moving point first comes within
+// radius of center.
+static bool sweep_point_circle(const SGFixedVector2Internal &start, const SGFixedVector2Internal &motion, const SGFixedVector2Internal &center, fixed radius, fixed &r_time) {
+	SGFixedVector2Internal f = start - center;
+
+	fixed c = f.dot(f) - (radius * radius);
+	if (c <= fixed::ZERO) {
+		// We're already there.
+		r_time = fixed::ZERO;
+		return true;
+	}
+
+	fixed b = f.dot(motion);
+	if (b >= fixed::ZERO) {
+		// We're moving away.
+		return false;
+	}
+
+	fixed a = motion.dot(motion);
+
+#ifdef SG_FIXED_WIDE_MATH
+	// The discriminant has 32 fractional bits, so its square root has the
+	// usual 16. Since a and c are positive, it's no bigger than b * b, and the
+	// square root fits back into 64-bits.
+	__int128 discriminant = (__int128)b.value * b.value - (__int128)a.value * c.value;
+	if (discriminant < 0) {
+		return false;
+	}
+
+	fixed distance = -b - fixed((int64_t)sg_sqrt_128((unsigned __int128)discriminant));
+#else
+	// Reduce precision to 8 fractional bits to calculate the determinant, in
+	// an attempt to avoid overflowing 64-bits.
+	int64_t small_a = a.value >> 8;
+	int64_t small_b = b.value >> 8;
+	int64_t small_c = c.value >> 8;
+
+	int64_t small_discriminant = (small_b * small_b) - (small_a * small_c);
+	if (small_discriminant < 0) {
+		return false;
+	}
+
+	fixed distance = -b - fixed(sg_sqrt_64(small_discriminant) << 8);
+#endif
+	if (distance > a) {
+		// We won't get there before the end of the motion.
+		return false;
+	}
+
+	r_time = distance > fixed::ZERO ? distance / a : fixed::ZERO;
+	return true;
+}
+
+bool SGCollisionDetector2DInternal::Circle_time_of_impact(const SGCircle2DInternal &circle, const SGShape2DInternal &shape, const SGFixedVector2Internal &motion, fixed &r_time, ImpactInfo *p_info) {
+	SGFixedTransform2DInternal t = circle.get_global_transform();
+	SGFixedVector2Internal center = t.get_origin();
+	// We only multiply by the scale.x because we don't support non-uniform scaling.
+	fixed radius = circle.get_radius() * t.get_scale().x;
+
+	if (shape.get_shape_type() == SGShape2DInternal::ShapeType::SHAPE_CIRCLE) {
+		const SGCircle2DInternal &circle2 = (const SGCircle2DInternal &)shape;
+		SGFixedTransform2DInternal t2 = circle2.get_global_transform();
+		fixed radius2 = circle2.get_radius() * t2.get_scale().x;
+
+		if (!sweep_point_circle(center, motion, t2.get_origin(), radius + radius2, r_time)) {
+			return false;
+		}
+		if (p_info) {
+			p_info->normal = (center + (motion * r_time) - t2.get_origin()).normalized();
+			p_info->point = t2.get_origin() + (p_info->normal * radius2);
+		}
+		return true;
+	}
+
+	// Sweeping a circle against a polygon is the same as sweeping its center
+	// against the polygon grown by the radius, which is outlined by the edges
+	// pushed out along their normals, and circles around the vertices.
+	Vector<SGFixedVector2Internal> verts = shape.get_global_vertices();
+	int count = verts.size();
+
+	bool hit = false;
+	fixed time;
+
+	for (int i = 0; i < count; i++) {
+		const SGFixedVector2Internal &a = verts[i];
+		const SGFixedVector2Internal &b = verts[(i + 1) % count];
+		SGFixedVector2Internal edge = b - a;
+
+		// Polygons can be wound either way, so make sure the normal points out.
+		SGFixedVector2Internal edge_normal = SGFixedVector2Internal(edge.y, -edge.x).normalized();
+		if (edge_normal.dot(verts[(i + 2) % count] - a) > fixed::ZERO) {
+			edge_normal = -edge_normal;
+		}
+
+		fixed speed = -edge_normal.dot(motion);
+		fixed distance = edge_normal.dot(center - a) - radius;
+		if (speed > fixed::ZERO && distance >= fixed::ZERO && distance <= speed) {
+			fixed edge_time = distance / speed;
+			SGFixedVector2Internal contact = center + (motion * edge_time) - (edge_normal * radius);
+			fixed along = edge.dot(contact - a);
+			if (along >= fixed::ZERO && along <= edge.dot(edge) && (!hit || edge_time < time)) {
+				hit = true;
+				time = edge_time;
+				if (p_info) {
+					p_info->normal = edge_normal;
+					p_info->point = contact;
+				}
+			}
+		}
+
+		fixed vertex_time;
+		if (sweep_point_circle(center, motion, a, radius, vertex_time) && (!hit || vertex_time < time)) {
+			hit = true;
+			time = vertex_time;
+			if (p_info) {
+				p_info->normal = (center + (motion * vertex_time) - a).normalized();
+				p_info->point = a;
+			}
+		}
+	}
+
+	if (hit) {
+		r_time = time;
+	}
+	return hit;
+}
+
 // Algorithm from https://stackoverflow.com/a/565282
 //
 // License: CC BY-SA 3.0
@@ -344,8 +719,10 @@ bool SGCollisionDetector2DInternal::segment_intersects_segment(const SGFixedVect
 }
 
 bool SGCollisionDetector2DInternal::segment_intersects_Polygon(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, const SGShape2DInternal &polygon, SGFixedVector2Internal &p_intersection_point, SGFixedVector2Internal &p_collision_normal) {
-	Vector<SGFixedVector2Internal> verts = polygon.get_global_vertices();
+	return segment_intersects_Polygon(p_start, p_cast_to, polygon.get_global_vertices(), p_intersection_point, p_collision_normal);
+}
 
+bool SGCollisionDetector2DInternal::segment_intersects_Polygon(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, const Vector<SGFixedVector2Internal> &verts, SGFixedVector2Internal &p_intersection_point, SGFixedVector2Internal &p_collision_normal) {
 	bool intersecting = false;
 
 	SGFixedVector2Internal closest_intersection_point;
@@ -46,6 +46,10 @@ public:
 
 	static bool AABB_overlaps_AABB(const SGFixedRect2Internal &aabb1, const SGFixedRect2Internal &aabb2);
 
+	// A cheap, conservative test to run before the narrowphase: if this
+	// returns false, the shapes definitely don't overlap.
+	static bool bounding_circles_overlap(const SGShape2DInternal &shape1, const SGShape2DInternal &shape2);
+
 	//
 	// SAT testing utilities
 	//
@@ -54,13 +58,18 @@ public:
 	static Interval get_interval(const SGShape2DInternal &shape, const SGFixedVector2Internal &axis);
 
 	static bool overlaps_on_axis(const SGShape2DInternal &shape1, const SGShape2DInternal &shape2, const SGFixedVector2Internal &axis, fixed &separation);
-	static bool sat_test(const SGShape2DInternal &shape1, const SGShape2DInternal &shape2, const Vector<SGFixedVector2Internal> &axes, SGFixedVector2Internal &best_separation_vector);
+	static bool sat_test(const SGShape2DInternal &shape1, const SGShape2DInternal &shape2, const Vector<SGFixedVector2Internal> &axes, SGFixedVector2Internal &best_separation_vector, int *p_separating_axis = nullptr);
+
+	// Axis hints are indexes into the first shape's axes, followed by the
+	// second shape's axes. Trying the hinted axis first can only find a
+	// separation sooner; it never changes the result.
+	static bool is_separating_axis(const SGShape2DInternal &shape1, const SGShape2DInternal &shape2, const Vector<SGFixedVector2Internal> &axes1, const Vector<SGFixedVector2Internal> &axes2, int axis);
 
 	//
 	// Rectangles
 	//
 
-	static bool Rectangle_overlaps_Rectangle(const SGRectangle2DInternal &rectangle1, const SGRectangle2DInternal &rectangle2, OverlapInfo *p_info = nullptr);
+	static bool Rectangle_overlaps_Rectangle(const SGRectangle2DInternal &rectangle1, const SGRectangle2DInternal &rectangle2, OverlapInfo *p_info = nullptr, int *p_axis_hint = nullptr);
 
 	//
 	// Circles
@@ -74,9 +83,28 @@ public:
 	// Polygons
 	//
 
-	static bool Polygon_overlaps_Polygon(const SGPolygon2DInternal &polygon1, const SGPolygon2DInternal &polygon2, OverlapInfo *p_info = nullptr);
-	static bool Polygon_overlaps_Circle(const SGPolygon2DInternal &polygon, const SGCircle2DInternal &circle, OverlapInfo *p_info = nullptr);
-	static bool Polygon_overlaps_Rectangle(const SGPolygon2DInternal &polygon, const SGRectangle2DInternal &rectangle, OverlapInfo *p_info = nullptr);
+	static bool Polygon_overlaps_Polygon(const SGPolygon2DInternal &polygon1, const SGPolygon2DInternal &polygon2, OverlapInfo *p_info = nullptr, int *p_axis_hint = nullptr);
+	static bool Polygon_overlaps_Circle(const SGPolygon2DInternal &polygon, const SGCircle2DInternal &circle, OverlapInfo *p_info = nullptr, int *p_axis_hint = nullptr);
+	static bool Polygon_overlaps_Rectangle(const SGPolygon2DInternal &polygon, const SGRectangle2DInternal &rectangle, OverlapInfo *p_info = nullptr, int *p_axis_hint = nullptr);
+
+
+	//
+	// Time of impact
+	//
+
+	struct ImpactInfo {
+		// Points from shape2 towards shape1.
+		SGFixedVector2Internal normal;
+		SGFixedVector2Internal point;
+	};
+
+	// Finds the fraction of the motion at which shape1 first touches shape2,
+	// by sweeping their intervals along each axis. This only works for
+	// rectangles and polygons. Returns false if they don't touch.
+	static bool Polygon_time_of_impact(const SGShape2DInternal &shape1, const SGShape2DInternal &shape2, const SGFixedVector2Internal &motion, fixed &r_time, ImpactInfo *p_info = nullptr);
+	// The shape can be a circle, rectangle or polygon, but mustn't already
+	// overlap the circle.
+	static bool Circle_time_of_impact(const SGCircle2DInternal &circle, const SGShape2DInternal &shape, const SGFixedVector2Internal &motion, fixed &r_time, ImpactInfo *p_info = nullptr);
 
 
 	//
@@ -88,6 +116,7 @@ public:
 	// since they are both polygons with connected vertices returned by
 	// get_global_vertices().
 	static bool segment_intersects_Polygon(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, const SGShape2DInternal &polygon, SGFixedVector2Internal &p_intersection_point, SGFixedVector2Internal &p_collision_normal);
+	static bool segment_intersects_Polygon(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, const Vector<SGFixedVector2Internal> &p_verts, SGFixedVector2Internal &p_intersection_point, SGFixedVector2Internal &p_collision_normal);
 	static bool segment_intersects_Circle(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, const SGCircle2DInternal &circle, SGFixedVector2Internal &p_intersection_point, SGFixedVector2Internal &p_collision_normal);
 
 };
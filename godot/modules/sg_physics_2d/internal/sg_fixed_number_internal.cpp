@@ -23,12 +23,40 @@
 
 #include "sg_fixed_number_internal.h"
 
-#include "../thirdparty/libfixmath/fixmath.h"
+// Returns the number of bits needed to represent p_value (ie. the index of
+// the highest set bit plus one, or 0 if p_value is 0).
+static _FORCE_INLINE_ int sg_bit_length_64(uint64_t p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+	return p_value == 0 ? 0 : 64 - __builtin_clzll(p_value);
+#else
+	int bits = 0;
+	for (int shift = 32; shift > 0; shift >>= 1) {
+		if ((p_value >> shift) != 0) {
+			p_value >>= shift;
+			bits += shift;
+		}
+	}
+	return bits + (int)p_value;
+#endif
+}
+
+// ceil(sqrt(i + 1) * 16), used for the initial estimate in sg_sqrt_64().
+static const uint16_t sg_sqrt_estimate_table[] = {
+	16, 23, 28, 32, 36, 40, 43, 46, 48, 51, 54, 56, 58, 60, 62, 64,
+	66, 68, 70, 72, 74, 76, 77, 79, 80, 82, 84, 85, 87, 88, 90, 91,
+	92, 94, 95, 96, 98, 99, 100, 102, 103, 104, 105, 107, 108, 109, 110, 111,
+	112, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128,
+};
 
 /**
- * Copied from https://en.wikipedia.org/wiki/Methods_of_computing_square_roots#Binary_numeral_system_.28base_2.29
- * but modified to use 64-bit numbers.
- * 
+ * Returns the integer square root (rounded down) of num.
+ *
+ * The top 5 or 6 bits of num are used to look up an estimate that's at least
+ * the real square root, and then three Newton iterations get it to within one
+ * or two of the answer. Newton's method on integers never goes below the
+ * integer square root when starting above it, so the final correction only
+ * needs to step down.
+ *
  * Like fix16_sqrt(), for negative numbers we return the negated square root of
  * the absolute value (ie. sqrt(-x) = -sqrt(x)).
  */
@@ -38,113 +66,240 @@ int64_t sg_sqrt_64(int64_t num) {
 	}
 
 	bool neg = num < 0;
-	if (neg) {
-		num = -num;
+	uint64_t n = neg ? (uint64_t)0 - (uint64_t)num : (uint64_t)num;
+
+	// Use an even shift, so it can be halved for the square root.
+	int bits = sg_bit_length_64(n);
+	int shift = bits > 6 ? (bits - 5) & ~1 : 0;
+	uint64_t res = (((uint64_t)sg_sqrt_estimate_table[n >> shift] << (shift >> 1)) + 15) >> 4;
+
+	res = (res + n / res) >> 1;
+	res = (res + n / res) >> 1;
+	res = (res + n / res) >> 1;
+
+	while (res * res > n) {
+		res--;
+	}
+
+	return neg ? -(int64_t)res : (int64_t)res;
+}
+
+//
+// The trigonometric functions below work internally with 30 fractional bits
+// (rather than the usual 16) so that the result can be rounded to the nearest
+// fixed-point value. Only 64-bit integer math is used, so they give the same
+// result on every platform.
+//
+
+#define SG_TRIG_ONE (1LL << 30)
+#define SG_TRIG_PI 3373259426LL
+#define SG_TRIG_HALF_PI 1686629713LL
+#define SG_TRIG_QUARTER_PI 843314857LL
+
+// The bits of PI/2 beyond the first 30 fractional bits (ie. PI/2 with 60
+// fractional bits is (SG_TRIG_HALF_PI << 30) + SG_TRIG_HALF_PI_LOW).
+#define SG_TRIG_HALF_PI_LOW 70064198LL
+
+// 2/PI with 31 fractional bits, used to estimate the quadrant.
+#define SG_TRIG_TWO_DIV_PI 1367130551LL
+
+// Inputs beyond this can't be shifted up to 30 fractional bits.
+#define SG_TRIG_MAX_INPUT (1LL << 47)
+
+// Inputs below this can have their quadrant estimated without a division.
+#define SG_TRIG_MAX_ESTIMATE_INPUT (1LL << 31)
+
+// atan(2^-i) with 30 fractional bits, for CORDIC.
+static const int64_t sg_trig_atan_table[] = {
+	843314857, 497837829, 263043837, 133525159, 67021687, 33543516, 16775851, 8388437,
+	4194283, 2097149, 1048576, 524288, 262144, 131072, 65536, 32768,
+};
+
+static _FORCE_INLINE_ int64_t sg_trig_round(int64_t p_value) {
+	return (p_value + (1LL << 13)) >> 14;
+}
+
+// Calculates sin() and cos() of the fixed-point angle p_value, both with 30
+// fractional bits.
+static void sg_trig_sincos(int64_t p_value, int64_t &r_sin, int64_t &r_cos) {
+	if (p_value >= SG_TRIG_MAX_INPUT || p_value <= -SG_TRIG_MAX_INPUT) {
+		p_value %= fixed::TAU.value;
 	}
-	int64_t res = 0;
-	int64_t bit = 1LL << 62;
 
-	// Start bit at the highest power of four that's less than or equal to num.
-	while (bit > num) {
-		bit >>= 2;
+	// Reduce to [0, PI/2) and the quadrant. Using the extra bits of PI/2 keeps
+	// the remainder accurate, even for large angles.
+	int64_t x = p_value * (1LL << 14);
+	int64_t quadrant;
+	if (p_value < SG_TRIG_MAX_ESTIMATE_INPUT && p_value > -SG_TRIG_MAX_ESTIMATE_INPUT) {
+		// This is off by at most one, which is corrected below.
+		quadrant = (p_value * SG_TRIG_TWO_DIV_PI) >> 47;
 	}
-	
-	while (bit != 0) {
-		if (num >= res + bit) {
-			num -= res + bit;
-			res = (res >> 1) + bit;
-		}
-		else {
-			res >>= 1;
-		}
-		bit >>= 2;
+	else {
+		quadrant = x / SG_TRIG_HALF_PI;
+	}
+	int64_t r = x - quadrant * SG_TRIG_HALF_PI - ((quadrant * SG_TRIG_HALF_PI_LOW) >> 30);
+	if (r < 0) {
+		quadrant -= 1;
+		r += SG_TRIG_HALF_PI;
+	}
+	else if (r >= SG_TRIG_HALF_PI) {
+		quadrant += 1;
+		r -= SG_TRIG_HALF_PI;
 	}
 
-	return neg ? -res : res;
-}
+	// Reduce to [0, PI/4], since sin(PI/2 - r) = cos(r).
+	bool swap = r > SG_TRIG_QUARTER_PI;
+	if (swap) {
+		r = SG_TRIG_HALF_PI - r;
+	}
 
-const fixed fixed::ZERO = fixed(0);
-const fixed fixed::ONE  = fixed(fix16_one);
-const fixed fixed::HALF = fixed(32768);
-const fixed fixed::TWO  = fixed(131072);
-const fixed fixed::NEG_ONE = fixed(-fix16_one);
-const fixed fixed::PI = fixed(fix16_pi);
-const fixed fixed::TAU = fixed(fix16_pi << 1);
-const fixed fixed::PI_DIV_4 = fixed(PI_DIV_4);
-const fixed fixed::EPSILON = fixed(fix16_eps);
-const fixed fixed::ARITHMETIC_OVERFLOW = fixed(INT64_MIN);
+	// Taylor series, which is accurate to better than 2^-32 on [0, PI/4].
+	int64_t r2 = (r * r) >> 30;
 
-fixed fixed::sin() const {
-	if (value < fix16_maximum && value > fix16_minimum) {
-		return fixed(fix16_sin(value));
+	int64_t s = SG_TRIG_ONE;
+	s = SG_TRIG_ONE - ((r2 * s) >> 30) / 110;
+	s = SG_TRIG_ONE - ((r2 * s) >> 30) / 72;
+	s = SG_TRIG_ONE - ((r2 * s) >> 30) / 42;
+	s = SG_TRIG_ONE - ((r2 * s) >> 30) / 20;
+	s = SG_TRIG_ONE - ((r2 * s) >> 30) / 6;
+	s = (r * s) >> 30;
+
+	int64_t c = SG_TRIG_ONE;
+	c = SG_TRIG_ONE - ((r2 * c) >> 30) / 90;
+	c = SG_TRIG_ONE - ((r2 * c) >> 30) / 56;
+	c = SG_TRIG_ONE - ((r2 * c) >> 30) / 30;
+	c = SG_TRIG_ONE - ((r2 * c) >> 30) / 12;
+	c = SG_TRIG_ONE - ((r2 * c) >> 30) / 2;
+
+	if (swap) {
+		int64_t tmp = s;
+		s = c;
+		c = tmp;
 	}
 
-	int64_t remainder = value % fixed::TAU.value;
-	return fixed(fix16_sin(remainder));
+	switch (quadrant & 3) {
+		case 0:
+			r_sin = s;
+			r_cos = c;
+			break;
+		case 1:
+			r_sin = c;
+			r_cos = -s;
+			break;
+		case 2:
+			r_sin = -s;
+			r_cos = -c;
+			break;
+		default:
+			r_sin = -c;
+			r_cos = s;
+			break;
+	}
 }
 
-fixed fixed::cos() const {
-	// libfixmath's fix16_cos(0) will return 65537, rather than the correct
-	// result of 65536. Because cos(0) is used when generating rotation
-	// matrices with a rotation of 0, we need cos(0) to be 65536 to match the
-	// identity matrix.
-	//
-	// @todo Remove after we've replaced libfixmatch per issue #4:
-	//       https://gitlab.com/snopek-games/sg-physics-2d/-/issues/4
-	if (value == 0) {
-		return fixed(65536);
+// Rounds a value with 30 fractional bits to the nearest fixed-point value,
+// rounding halves away from zero so that odd functions stay symmetric.
+static _FORCE_INLINE_ int64_t sg_trig_round_symmetric(int64_t p_value) {
+	return p_value < 0 ? -sg_trig_round(-p_value) : sg_trig_round(p_value);
+}
+
+// Calculates atan2(p_y, p_x) with 30 fractional bits, using CORDIC. The inputs
+// can have any number of fractional bits, as long as it's the same for both.
+static int64_t sg_trig_atan2(int64_t p_y, int64_t p_x) {
+	if (p_x == 0 && p_y == 0) {
+		return 0;
+	}
+
+	// Work out the angle in the first quadrant, and then mirror it.
+	uint64_t ax = p_x < 0 ? (uint64_t)0 - (uint64_t)p_x : (uint64_t)p_x;
+	uint64_t ay = p_y < 0 ? (uint64_t)0 - (uint64_t)p_y : (uint64_t)p_y;
+
+	// Only the ratio matters, so scale so the largest is 30 bits.
+	int bits = sg_bit_length_64(ax > ay ? ax : ay);
+	int64_t x, y;
+	if (bits > 30) {
+		x = (int64_t)(ax >> (bits - 30));
+		y = (int64_t)(ay >> (bits - 30));
+	}
+	else {
+		x = (int64_t)(ax << (30 - bits));
+		y = (int64_t)(ay << (30 - bits));
 	}
 
-	if (value < fix16_maximum && value > fix16_minimum) {
-		return fixed(fix16_cos(value));
+	// Rotate the vector towards the x-axis, adding up the angles. The masks
+	// negate the steps when y is negative, so no branches are needed.
+	int64_t angle = 0;
+	for (int i = 0; i < 16; i++) {
+		int64_t mask = y >> 63;
+		int64_t x_step = x >> i;
+		int64_t y_step = y >> i;
+		x += (y_step ^ mask) - mask;
+		y -= (x_step ^ mask) - mask;
+		angle += (sg_trig_atan_table[i] ^ mask) - mask;
 	}
 
-	int64_t remainder = value % fixed::TAU.value;
-	return fixed(fix16_cos(remainder));
+	// The remaining angle is less than 2^-15, where atan(y/x) = y/x to
+	// better than 2^-45.
+	angle += (y * SG_TRIG_ONE) / x;
+
+	if (p_x < 0) {
+		angle = SG_TRIG_PI - angle;
+	}
+	return p_y < 0 ? -angle : angle;
+}
+
+void fixed::sincos(fixed &r_sin, fixed &r_cos) const {
+	int64_t s, c;
+	sg_trig_sincos(value, s, c);
+	r_sin = fixed(sg_trig_round_symmetric(s));
+	r_cos = fixed(sg_trig_round_symmetric(c));
+}
+
+fixed fixed::sin() const {
+	int64_t s, c;
+	sg_trig_sincos(value, s, c);
+	return fixed(sg_trig_round_symmetric(s));
+}
+
+fixed fixed::cos() const {
+	int64_t s, c;
+	sg_trig_sincos(value, s, c);
+	return fixed(sg_trig_round_symmetric(c));
 }
 
 fixed fixed::tan() const {
-	if (value < fix16_maximum && value > fix16_minimum) {
-		return fixed(fix16_tan(value));
+	int64_t s, c;
+	sg_trig_sincos(value, s, c);
+	if (c == 0) {
+		return s < 0 ? fixed(INT64_EFFECTIVE_MIN) : fixed(INT64_MAX);
 	}
 
-	int64_t remainder = value % fixed::PI.value;
-	return fixed(fix16_tan(remainder));
+	// Divide with one extra bit, so the result can be rounded.
+	int64_t result = (s * (1LL << 17)) / c;
+	return fixed(result < 0 ? -((1 - result) >> 1) : (result + 1) >> 1);
 }
 
 fixed fixed::asin() const {
-	if (value < fix16_maximum && value > fix16_minimum) {
-		return fixed(fix16_asin(value));
-	}
-
-	int64_t remainder = value % fixed::TAU.value;
-	return fixed(fix16_asin(remainder));
+	// asin(v) = atan2(v, sqrt(1 - v^2)), which is calculated with 30
+	// fractional bits. Values outside [-1, 1] are clamped.
+	int64_t v = CLAMP(value, -ONE.value, ONE.value);
+	int64_t x = sg_sqrt_64(((1LL << 32) - v * v) << 28);
+	return fixed(sg_trig_round_symmetric(sg_trig_atan2(v << 14, x)));
 }
 
 fixed fixed::acos() const {
-	if (value < fix16_maximum && value > fix16_minimum) {
-		return fixed(fix16_acos(value));
-	}
-
-	int64_t remainder = value % fixed::TAU.value;
-	return fixed(fix16_acos(remainder));
+	// acos(v) = atan2(sqrt(1 - v^2), v), which is calculated with 30
+	// fractional bits. Values outside [-1, 1] are clamped.
+	int64_t v = CLAMP(value, -ONE.value, ONE.value);
+	int64_t y = sg_sqrt_64(((1LL << 32) - v * v) << 28);
+	return fixed(sg_trig_round(sg_trig_atan2(y, v << 14)));
 }
 
 fixed fixed::atan() const {
-	if (value < fix16_maximum && value > fix16_minimum) {
-		return fixed(fix16_atan(value));
-	}
-
-	int64_t remainder = value % fixed::TAU.value;
-	return fixed(fix16_atan(remainder));
+	return fixed(sg_trig_round_symmetric(sg_trig_atan2(value, ONE.value)));
 }
 
 fixed fixed::atan2(const fixed &inY) const {
-	if (value < fix16_maximum && value > fix16_minimum) {
-		return fixed(fix16_atan2(value, inY.value));
-	}
-
-	int64_t x = value % fixed::PI.value;
-	int64_t y = inY.value % fixed::PI.value;
-	return fixed(fix16_atan2(x, y));
+	// Despite the name, inY is the x coordinate, and this is the y coordinate.
+	return fixed(sg_trig_round_symmetric(sg_trig_atan2(value, inY.value)));
 }
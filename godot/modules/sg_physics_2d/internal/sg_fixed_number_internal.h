@@ -38,26 +38,59 @@ int64_t sg_sqrt_64(int64_t num);
 #define SG_FIXED_MATH_CHECKS
 #endif
 
-struct fixed {
+// When the compiler has a 128-bit integer type, multiplication and division
+// use it for the intermediate result, which can't overflow, so only the final
+// result needs to be checked. Building with SG_FIXED_LEGACY_MATH (or on a
+// compiler without 128-bit integers) uses 64-bit intermediates instead, which
+// overflow for operands above ~2^23 (or ~2^31 for the dividend).
+//
+// Both give exactly the same results whenever the 64-bit version doesn't
+// overflow.
+#if defined(__SIZEOF_INT128__) && !defined(SG_FIXED_LEGACY_MATH)
+#define SG_FIXED_WIDE_MATH
+#endif
+
+struct fixed;
+
+template <char... Cs>
+constexpr fixed operator"" _fx();
+
+// The object behind each constant. It's extern so that every translation unit
+// shares the same one.
+template <typename T, int64_t V>
+extern constexpr T sg_fixed_constant = T(V);
+
+// The constants are static members of a class template, because only
+// templates can define static members in a header without breaking the one
+// definition rule before C++17. They're references, because 'fixed' is still
+// incomplete here, and a constexpr object needs a complete type while a
+// constexpr reference doesn't. They can still be used in constant
+// expressions, and the compiler folds them into the code using them.
+template <typename T>
+struct SGFixedConstants {
+	static constexpr const T &ZERO = sg_fixed_constant<T, 0>;
+	static constexpr const T &ONE = sg_fixed_constant<T, 65536>;
+	static constexpr const T &HALF = sg_fixed_constant<T, 32768>;
+	static constexpr const T &TWO = sg_fixed_constant<T, 131072>;
+	static constexpr const T &NEG_ONE = sg_fixed_constant<T, -65536>;
+	// These are rounded down (rather than to the nearest, like a literal
+	// would be), and changing them would change simulation results.
+	static constexpr const T &PI = sg_fixed_constant<T, 205887>;
+	static constexpr const T &TAU = sg_fixed_constant<T, 411774>;
+	static constexpr const T &PI_DIV_4 = sg_fixed_constant<T, 51471>;
+	static constexpr const T &EPSILON = sg_fixed_constant<T, 1>;
+	static constexpr const T &ARITHMETIC_OVERFLOW = sg_fixed_constant<T, INT64_MIN>;
+};
+
+struct fixed : public SGFixedConstants<fixed> {
 	int64_t value;
 
-	_FORCE_INLINE_ fixed() : value(0) {}
+	_FORCE_INLINE_ constexpr fixed() : value(0) {}
 
-	explicit _FORCE_INLINE_ fixed(int64_t p_initial_value)
+	explicit _FORCE_INLINE_ constexpr fixed(int64_t p_initial_value)
 		: value(p_initial_value) {}
 
-	static const fixed ZERO;
-	static const fixed ONE;
-	static const fixed HALF;
-	static const fixed TWO;
-	static const fixed NEG_ONE;
-	static const fixed PI;
-	static const fixed TAU;
-	static const fixed PI_DIV_4;
-	static const fixed EPSILON;
-	static const fixed ARITHMETIC_OVERFLOW;
-
-	static _FORCE_INLINE_ fixed from_int(int64_t p_int_value) {
+	static _FORCE_INLINE_ constexpr fixed from_int(int64_t p_int_value) {
 		return fixed(p_int_value << 16);
 	}
 	
@@ -83,7 +116,7 @@ struct fixed {
 		return (a - b).abs() < tolerance;
 	}
 
-	_FORCE_INLINE_ int64_t to_int() const {
+	_FORCE_INLINE_ constexpr int64_t to_int() const {
 		return value >> 16;
 	}
 
@@ -122,6 +155,16 @@ struct fixed {
 	}
 
 	_FORCE_INLINE_ fixed operator*(const fixed& p_other) const {
+		#ifdef SG_FIXED_WIDE_MATH
+		__int128 result = ((__int128)value * p_other.value) >> 16;
+
+		#ifdef SG_FIXED_MATH_CHECKS
+		ERR_FAIL_COND_V_MSG(result > INT64_MAX || result < INT64_EFFECTIVE_MIN,
+			fixed::ARITHMETIC_OVERFLOW, "Fixed-point multiplication overflow");
+		#endif
+
+		return fixed((int64_t)result);
+		#else
 		#ifdef SG_FIXED_MATH_CHECKS
 		ERR_FAIL_COND_V_MSG(value == -1 && p_other.value == INT64_MAX,
 			fixed::ARITHMETIC_OVERFLOW, "Fixed-point multiplication overflow");
@@ -134,6 +177,7 @@ struct fixed {
 		#endif
 
 		return fixed((value * p_other.value) >> 16);
+		#endif
 	}
 
 	_FORCE_INLINE_ void operator*=(const fixed& p_other) {
@@ -141,6 +185,16 @@ struct fixed {
 	}
 
 	_FORCE_INLINE_ fixed operator/(const fixed& p_other) const {
+		#ifdef SG_FIXED_WIDE_MATH
+		__int128 result = ((__int128)value << 16) / p_other.value;
+
+		#ifdef SG_FIXED_MATH_CHECKS
+		ERR_FAIL_COND_V_MSG(result > INT64_MAX || result < INT64_EFFECTIVE_MIN,
+			fixed::ARITHMETIC_OVERFLOW, "Fixed-point division overflow");
+		#endif
+
+		return fixed((int64_t)result);
+		#else
 		#ifdef SG_FIXED_MATH_CHECKS
 		ERR_FAIL_COND_V_MSG(value == -1 && p_other.value == INT64_MAX,
 			fixed::ARITHMETIC_OVERFLOW, "Fixed-point division overflow");
@@ -149,23 +203,43 @@ struct fixed {
 		#endif
 
 		return fixed((value << 16) / p_other.value);
+		#endif
 	}
 
 	_FORCE_INLINE_ void operator/=(const fixed& p_other) {
 		value = (*this / p_other).value;
 	}
 
-	_FORCE_INLINE_ bool operator==(const fixed &p_other) const { return value == p_other.value; }
-	_FORCE_INLINE_ bool operator!=(const fixed &p_other) const { return value != p_other.value; }
-	_FORCE_INLINE_ bool operator<=(const fixed &p_other) const { return value <= p_other.value; }
-	_FORCE_INLINE_ bool operator>=(const fixed &p_other) const { return value >= p_other.value; }
-	_FORCE_INLINE_ bool operator< (const fixed &p_other) const { return value <  p_other.value; }
-	_FORCE_INLINE_ bool operator> (const fixed &p_other) const { return value >  p_other.value; }
+	// Returns (this * p_mul) / p_div, rounded the same way as using the
+	// operators, but without overflowing on the intermediate product.
+	_FORCE_INLINE_ fixed muldiv(const fixed &p_mul, const fixed &p_div) const {
+		#ifdef SG_FIXED_WIDE_MATH
+		__int128 result = ((((__int128)value * p_mul.value) >> 16) << 16) / p_div.value;
 
-	_FORCE_INLINE_ fixed abs() const { return (value < 0) ? fixed(-value) : *this; }
-	_FORCE_INLINE_ fixed operator-() const { return fixed(-value); }
+		#ifdef SG_FIXED_MATH_CHECKS
+		ERR_FAIL_COND_V_MSG(result > INT64_MAX || result < INT64_EFFECTIVE_MIN,
+			fixed::ARITHMETIC_OVERFLOW, "Fixed-point multiplication and division overflow");
+		#endif
+
+		return fixed((int64_t)result);
+		#else
+		return (*this * p_mul) / p_div;
+		#endif
+	}
+
+	_FORCE_INLINE_ constexpr bool operator==(const fixed &p_other) const { return value == p_other.value; }
+	_FORCE_INLINE_ constexpr bool operator!=(const fixed &p_other) const { return value != p_other.value; }
+	_FORCE_INLINE_ constexpr bool operator<=(const fixed &p_other) const { return value <= p_other.value; }
+	_FORCE_INLINE_ constexpr bool operator>=(const fixed &p_other) const { return value >= p_other.value; }
+	_FORCE_INLINE_ constexpr bool operator< (const fixed &p_other) const { return value <  p_other.value; }
+	_FORCE_INLINE_ constexpr bool operator> (const fixed &p_other) const { return value >  p_other.value; }
+
+	_FORCE_INLINE_ constexpr fixed abs() const { return (value < 0) ? fixed(-value) : *this; }
+	_FORCE_INLINE_ constexpr fixed operator-() const { return fixed(-value); }
 	_FORCE_INLINE_ fixed sqrt() const { return fixed(sg_sqrt_64(value << 16)); }
-	_FORCE_INLINE_ fixed sign() const { return value < 0 ? fixed::NEG_ONE : (value > 0 ? fixed::ONE : fixed::ZERO); }
+	_FORCE_INLINE_ constexpr fixed sign() const { return value < 0 ? -1_fx : (value > 0 ? 1_fx : 0_fx); }
+
+	void sincos(fixed &r_sin, fixed &r_cos) const;
 
 	fixed  sin() const;
 	fixed  cos() const;
@@ -176,6 +250,65 @@ struct fixed {
 	fixed atan2(const fixed &inY) const;
 };
 
+// Parses the characters of a decimal literal (like "1.5" or "42") into a
+// fixed-point value, rounded to the nearest. Only integer math is used, so the
+// result doesn't depend on the compiler's floating-point support. Fractional
+// digits beyond the 14th are ignored. Returns -1 for anything that isn't a
+// plain decimal number.
+constexpr int64_t sg_parse_fixed_literal(const char *p_chars, int p_length) {
+	uint64_t integer = 0;
+	uint64_t fraction = 0;
+	uint64_t scale = 1;
+	bool in_fraction = false;
+	for (int i = 0; i < p_length; i++) {
+		char c = p_chars[i];
+		if (c == '\'') {
+			continue;
+		}
+		if (c == '.' && !in_fraction) {
+			in_fraction = true;
+			continue;
+		}
+		if (c < '0' || c > '9') {
+			return -1;
+		}
+		if (!in_fraction) {
+			integer = integer * 10 + (c - '0');
+			if (integer > (uint64_t)(INT64_MAX >> 16)) {
+				return -1;
+			}
+		}
+		else if (scale < 100000000000000ULL) {
+			fraction = fraction * 10 + (c - '0');
+			scale *= 10;
+		}
+	}
+	return (int64_t)((integer << 16) + (fraction * 65536 + scale / 2) / scale);
+}
+
+// A fixed-point literal, for example 1.5_fx or 32_fx, which is always
+// converted at compile time.
+template <char... Cs>
+constexpr fixed operator"" _fx() {
+	constexpr char chars[] = { Cs... };
+	constexpr int64_t value = sg_parse_fixed_literal(chars, sizeof...(Cs));
+	static_assert(value >= 0, "Invalid fixed-point literal");
+	return fixed(value);
+}
+
+template <typename T> constexpr const T &SGFixedConstants<T>::ZERO;
+template <typename T> constexpr const T &SGFixedConstants<T>::ONE;
+template <typename T> constexpr const T &SGFixedConstants<T>::HALF;
+template <typename T> constexpr const T &SGFixedConstants<T>::TWO;
+template <typename T> constexpr const T &SGFixedConstants<T>::NEG_ONE;
+template <typename T> constexpr const T &SGFixedConstants<T>::PI;
+template <typename T> constexpr const T &SGFixedConstants<T>::TAU;
+template <typename T> constexpr const T &SGFixedConstants<T>::PI_DIV_4;
+template <typename T> constexpr const T &SGFixedConstants<T>::EPSILON;
+template <typename T> constexpr const T &SGFixedConstants<T>::ARITHMETIC_OVERFLOW;
+
+static_assert(fixed::ONE == 1_fx && fixed::HALF == 0.5_fx && fixed::TWO == 2_fx && fixed::NEG_ONE == -1_fx, "Fixed-point constants don't match their literals");
+
 #define FIXED_SGN(m_v) (((m_v) < fixed::ZERO) ? fixed::NEG_ONE : fixed::ONE)
 
 #endif
@@ -66,8 +66,8 @@ fixed SGFixedTransform2DInternal::get_rotation() const {
 
 void SGFixedTransform2DInternal::set_rotation(fixed p_rot) {
 	SGFixedVector2Internal scale = get_scale();
-	fixed cr = p_rot.cos();
-	fixed sr = p_rot.sin();
+	fixed cr, sr;
+	p_rot.sincos(sr, cr);
 	elements[0][0] = cr;
 	elements[0][1] = sr;
 	elements[1][0] = -sr;
@@ -76,8 +76,8 @@ void SGFixedTransform2DInternal::set_rotation(fixed p_rot) {
 }
 
 SGFixedTransform2DInternal::SGFixedTransform2DInternal(fixed p_rot, const SGFixedVector2Internal &p_pos) {
-	fixed cr = p_rot.cos();
-	fixed sr = p_rot.sin();
+	fixed cr, sr;
+	p_rot.sincos(sr, cr);
 	elements[0][0] = cr;
 	elements[0][1] = sr;
 	elements[1][0] = -sr;
@@ -223,8 +223,9 @@ SGFixedTransform2DInternal SGFixedTransform2DInternal::interpolate_with(const SG
 	SGFixedVector2Internal s1 = get_scale();
 	SGFixedVector2Internal s2 = p_transform.get_scale();
 
-	SGFixedVector2Internal v1(r1.cos(), r1.sin());
-	SGFixedVector2Internal v2(r2.cos(), r2.sin());
+	SGFixedVector2Internal v1, v2;
+	v1.set_rotation(r1);
+	v2.set_rotation(r2);
 
 	fixed dot = v1.dot(v2);
 	dot = CLAMP(dot, fixed::NEG_ONE, fixed::ONE);
@@ -238,7 +239,9 @@ SGFixedTransform2DInternal SGFixedTransform2DInternal::interpolate_with(const SG
 	else {
 		fixed angle = p_c * dot.acos();
 		SGFixedVector2Internal v3 = (v2 - v1 * dot).normalized();
-		v = v1 * angle.cos() + v3 * angle.sin();
+		fixed ca, sa;
+		angle.sincos(sa, ca);
+		v = v1 * ca + v3 * sa;
 	}
 
 	SGFixedTransform2DInternal res(v.y.atan2(v.x), SGFixedVector2Internal::linear_interpolate(p1, p2, p_c));
@@ -133,10 +133,12 @@ SGFixedVector2Internal SGFixedTransform2DInternal::xform_inv(const SGFixedVector
 }
 
 void SGFixedTransform2DInternal::set_rotation_and_scale(fixed p_rot, const SGFixedVector2Internal &p_scale) {
-	elements[0][0] = p_rot.cos() * p_scale.x;
-	elements[1][1] = p_rot.cos() * p_scale.y;
-	elements[1][0] = -p_rot.sin() * p_scale.y;
-	elements[0][1] = p_rot.sin() * p_scale.x;
+	fixed cr, sr;
+	p_rot.sincos(sr, cr);
+	elements[0][0] = cr * p_scale.x;
+	elements[1][1] = cr * p_scale.y;
+	elements[1][0] = -sr * p_scale.y;
+	elements[0][1] = sr * p_scale.x;
 }
 
 #endif
@@ -23,9 +23,52 @@
 
 #include "sg_fixed_vector2_internal.h"
 
-const fixed SGFixedVector2Internal::FIXED_UNIT_EPSILON = fixed(65);
+constexpr fixed SGFixedVector2Internal::FIXED_UNIT_EPSILON;
+
+// Divides both components by the vector's length, giving exactly the same
+// result as 'x / length()' and 'y / length()'.
+//
+// With 128-bit division, fixed-point division is a lot slower than a plain
+// 64-bit one, so we instead find r = floor(2^62 / l) once for both components.
+// When |c| <= l < 2^32, the estimate (|c| * r) >> 46 is either the exact
+// quotient or one less than it, so checking the remainder once is enough to
+// correct it.
+static void sg_divide_by_length(fixed &r_x, fixed &r_y) {
+#ifdef SG_FIXED_WIDE_MATH
+	// Beyond this, length_squared() can overflow, so leave it to regular
+	// division, which matches whatever length() gives in that case.
+	const int64_t limit = ((int64_t)1) << 31;
+	if (r_x.value > -limit && r_x.value < limit && r_y.value > -limit && r_y.value < limit) {
+		uint64_t l = (uint64_t)sg_sqrt_64(r_x.value * r_x.value + r_y.value * r_y.value);
+		if (l == 0) {
+			return;
+		}
+		uint64_t reciprocal = (((uint64_t)1) << 62) / l;
+
+		uint64_t x_abs = (uint64_t)r_x.abs().value;
+		uint64_t qx = (x_abs * reciprocal) >> 46;
+		if ((x_abs << 16) - qx * l >= l) {
+			qx++;
+		}
+
+		uint64_t y_abs = (uint64_t)r_y.abs().value;
+		uint64_t qy = (y_abs * reciprocal) >> 46;
+		if ((y_abs << 16) - qy * l >= l) {
+			qy++;
+		}
+
+		r_x.value = r_x.value < 0 ? -(int64_t)qx : (int64_t)qx;
+		r_y.value = r_y.value < 0 ? -(int64_t)qy : (int64_t)qy;
+		return;
+	}
+#endif
 
-const SGFixedVector2Internal SGFixedVector2Internal::ZERO = SGFixedVector2Internal(fixed::ZERO, fixed::ZERO);
+	fixed l = SGFixedVector2Internal(r_x, r_y).length();
+	if (l != fixed::ZERO) {
+		r_x /= l;
+		r_y /= l;
+	}
+}
 
 bool SGFixedVector2Internal::operator==(const SGFixedVector2Internal &p_v) const {
 	return x == p_v.x && y == p_v.y;
@@ -40,10 +83,9 @@ fixed SGFixedVector2Internal::angle() const {
 }
 
 SGFixedVector2Internal SGFixedVector2Internal::rotated(fixed p_rotation) const {
-	SGFixedVector2Internal v;
-	v.set_rotation(angle() + p_rotation);
-	v *= length();
-	return v;
+	fixed c, s;
+	p_rotation.sincos(s, c);
+	return SGFixedVector2Internal(x * c - y * s, x * s + y * c);
 }
 
 void SGFixedVector2Internal::normalize() {
@@ -67,19 +109,13 @@ void SGFixedVector2Internal::normalize() {
 			// Multiply X and Y by 256.
 			fixed x_big = fixed(x.value << 8);
 			fixed y_big = fixed(y.value << 8);
-			fixed l = SGFixedVector2Internal(x_big, y_big).length();
-			if (l != fixed::ZERO) {
-				x = x_big / l;
-				y = y_big / l;
-			}
+			x = x_big;
+			y = y_big;
+			sg_divide_by_length(x, y);
 		}
 	}
 	else {
-		fixed l = length();
-		if (l != fixed::ZERO) {
-			x /= l;
-			y /= l;
-		}
+		sg_divide_by_length(x, y);
 	}
 }
 
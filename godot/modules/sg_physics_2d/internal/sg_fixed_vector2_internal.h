@@ -28,7 +28,17 @@
 
 #include "sg_fixed_number_internal.h"
 
-struct SGFixedVector2Internal {
+template <typename T>
+extern constexpr T sg_fixed_vector2_zero = T();
+
+// See SGFixedConstants for why this is a class template, and why its
+// constants are references.
+template <typename T>
+struct SGFixedVector2Constants {
+	static constexpr const T &ZERO = sg_fixed_vector2_zero<T>;
+};
+
+struct SGFixedVector2Internal : public SGFixedVector2Constants<SGFixedVector2Internal> {
 	enum Axis {
 		AXIS_X,
 		AXIS_Y,
@@ -43,8 +53,7 @@ struct SGFixedVector2Internal {
 		fixed height;
 	};
 
-	static const fixed FIXED_UNIT_EPSILON;
-	static const SGFixedVector2Internal ZERO;
+	static constexpr fixed FIXED_UNIT_EPSILON = fixed(65);
 
 	_FORCE_INLINE_ fixed &operator[](int p_idx) {
 		return p_idx ? y : x;
@@ -117,14 +126,13 @@ struct SGFixedVector2Internal {
 	fixed angle() const;
 
 	void set_rotation(fixed p_radians) {
-		x = p_radians.cos();
-		y = p_radians.sin();
+		p_radians.sincos(y, x);
 	}
 
-	_FORCE_INLINE_ SGFixedVector2Internal abs() const {
+	_FORCE_INLINE_ constexpr SGFixedVector2Internal abs() const {
 		return SGFixedVector2Internal(x.abs(), y.abs());
 	}
-	_FORCE_INLINE_ SGFixedVector2Internal operator-() const {
+	_FORCE_INLINE_ constexpr SGFixedVector2Internal operator-() const {
 		return SGFixedVector2Internal(-x, -y);
 	}
 
@@ -161,13 +169,15 @@ struct SGFixedVector2Internal {
 		return SGFixedVector2Internal(fixed::from_float(p_float_vector.x), fixed::from_float(p_float_vector.y));
 	}
 
-	_FORCE_INLINE_ SGFixedVector2Internal(fixed p_x, fixed p_y) 
+	_FORCE_INLINE_ constexpr SGFixedVector2Internal(fixed p_x, fixed p_y)
 		: x(p_x), y(p_y) {}
-	_FORCE_INLINE_ SGFixedVector2Internal()
-		: x(fixed::ZERO), y(fixed::ZERO) {}
+	_FORCE_INLINE_ constexpr SGFixedVector2Internal()
+		: x(0_fx), y(0_fx) {}
 
 };
 
+template <typename T> constexpr const T &SGFixedVector2Constants<T>::ZERO;
+
 SGFixedVector2Internal SGFixedVector2Internal::direction_to(const SGFixedVector2Internal &p_to) const {
 	SGFixedVector2Internal ret(p_to.x - x, p_to.y - y);
 	ret.normalize();
@@ -0,0 +1,166 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "sg_rectangle_merger_2d_internal.h"
+
+bool SGRectangleMerger2DInternal::RowComparator::operator()(const Entry &p_a, const Entry &p_b) const {
+	const SGFixedRect2Internal &a = p_a.rect;
+	const SGFixedRect2Internal &b = p_b.rect;
+	if (a.position.y != b.position.y) {
+		return a.position.y < b.position.y;
+	}
+	if (a.size.y != b.size.y) {
+		return a.size.y < b.size.y;
+	}
+	if (a.position.x != b.position.x) {
+		return a.position.x < b.position.x;
+	}
+	if (a.size.x != b.size.x) {
+		return a.size.x < b.size.x;
+	}
+	return p_a.id < p_b.id;
+}
+
+bool SGRectangleMerger2DInternal::ColumnComparator::operator()(const Entry &p_a, const Entry &p_b) const {
+	const SGFixedRect2Internal &a = p_a.rect;
+	const SGFixedRect2Internal &b = p_b.rect;
+	if (a.position.x != b.position.x) {
+		return a.position.x < b.position.x;
+	}
+	if (a.size.x != b.size.x) {
+		return a.size.x < b.size.x;
+	}
+	if (a.position.y != b.position.y) {
+		return a.position.y < b.position.y;
+	}
+	if (a.size.y != b.size.y) {
+		return a.size.y < b.size.y;
+	}
+	return p_a.id < p_b.id;
+}
+
+bool SGRectangleMerger2DInternal::merge_rows(Vector<Entry> &p_entries, Vector<int> &p_parents) {
+	if (p_entries.size() < 2) {
+		return false;
+	}
+
+	// Sorting puts rectangles in the same row next to each other, from left
+	// to right.
+	p_entries.sort_custom<RowComparator>();
+
+	Vector<Entry> merged;
+	Entry current = p_entries[0];
+	for (int i = 1; i < p_entries.size(); i++) {
+		const Entry &next = p_entries[i];
+		if (next.rect.position.y == current.rect.position.y && next.rect.size.y == current.rect.size.y && next.rect.position.x == current.rect.position.x + current.rect.size.x) {
+			current.rect.size.x += next.rect.size.x;
+			p_parents.write[next.id] = current.id;
+		}
+		else {
+			merged.push_back(current);
+			current = next;
+		}
+	}
+	merged.push_back(current);
+
+	bool changed = merged.size() != p_entries.size();
+	p_entries = merged;
+	return changed;
+}
+
+bool SGRectangleMerger2DInternal::merge_columns(Vector<Entry> &p_entries, Vector<int> &p_parents) {
+	if (p_entries.size() < 2) {
+		return false;
+	}
+
+	p_entries.sort_custom<ColumnComparator>();
+
+	Vector<Entry> merged;
+	Entry current = p_entries[0];
+	for (int i = 1; i < p_entries.size(); i++) {
+		const Entry &next = p_entries[i];
+		if (next.rect.position.x == current.rect.position.x && next.rect.size.x == current.rect.size.x && next.rect.position.y == current.rect.position.y + current.rect.size.y) {
+			current.rect.size.y += next.rect.size.y;
+			p_parents.write[next.id] = current.id;
+		}
+		else {
+			merged.push_back(current);
+			current = next;
+		}
+	}
+	merged.push_back(current);
+
+	bool changed = merged.size() != p_entries.size();
+	p_entries = merged;
+	return changed;
+}
+
+Vector<SGFixedRect2Internal> SGRectangleMerger2DInternal::merge(const Vector<SGFixedRect2Internal> &p_rects, Vector<int> *r_source_map) {
+	Vector<Entry> entries;
+	Vector<int> parents;
+	entries.resize(p_rects.size());
+	parents.resize(p_rects.size());
+	for (int i = 0; i < p_rects.size(); i++) {
+		entries.write[i].rect = p_rects[i];
+		entries.write[i].id = i;
+		parents.write[i] = i;
+	}
+
+	// Merging columns can line up rectangles so that they can be merged into
+	// rows again (and vice versa), so keep going until nothing changes.
+	bool changed = true;
+	while (changed) {
+		changed = merge_rows(entries, parents);
+		changed = merge_columns(entries, parents) || changed;
+	}
+
+	// Leave the result in row order.
+	entries.sort_custom<RowComparator>();
+
+	Vector<SGFixedRect2Internal> result;
+	result.resize(entries.size());
+	for (int i = 0; i < entries.size(); i++) {
+		result.write[i] = entries[i].rect;
+	}
+
+	if (r_source_map) {
+		// Each merged rectangle keeps the id of one of its sources, which the
+		// others point to (possibly through a chain of earlier merges).
+		Vector<int> id_to_result;
+		id_to_result.resize(p_rects.size());
+		for (int i = 0; i < entries.size(); i++) {
+			id_to_result.write[entries[i].id] = i;
+		}
+
+		r_source_map->resize(p_rects.size());
+		for (int i = 0; i < p_rects.size(); i++) {
+			int root = i;
+			while (parents[root] != root) {
+				root = parents[root];
+			}
+			r_source_map->write[i] = id_to_result[root];
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,58 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SG_RECTANGLE_MERGER_2D_INTERNAL_H
+#define SG_RECTANGLE_MERGER_2D_INTERNAL_H
+
+#include <core/vector.h>
+
+#include "sg_fixed_rect2_internal.h"
+
+class SGRectangleMerger2DInternal {
+	struct Entry {
+		SGFixedRect2Internal rect;
+		int id;
+	};
+
+	struct RowComparator {
+		bool operator()(const Entry &p_a, const Entry &p_b) const;
+	};
+
+	struct ColumnComparator {
+		bool operator()(const Entry &p_a, const Entry &p_b) const;
+	};
+
+	static bool merge_rows(Vector<Entry> &p_entries, Vector<int> &p_parents);
+	static bool merge_columns(Vector<Entry> &p_entries, Vector<int> &p_parents);
+
+public:
+	// Greedily merges axis-aligned rectangles that share a whole edge into
+	// larger ones. Rectangles are only merged when they exactly touch, so the
+	// area covered by the result is exactly the same as the input.
+	//
+	// If r_source_map is given, it'll be filled with the index of the merged
+	// rectangle that each input rectangle ended up in.
+	static Vector<SGFixedRect2Internal> merge(const Vector<SGFixedRect2Internal> &p_rects, Vector<int> *r_source_map = nullptr);
+};
+
+#endif
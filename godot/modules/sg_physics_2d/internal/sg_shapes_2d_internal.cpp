@@ -36,6 +36,37 @@ SGFixedTransform2DInternal SGShape2DInternal::get_global_transform() const {
 	return global_transform;
 }
 
+void SGShape2DInternal::update_global_bounding_radius() const {
+	SGFixedTransform2DInternal t = get_global_transform();
+	const SGFixedVector2Internal &x_axis = t.elements[0];
+	const SGFixedVector2Internal &y_axis = t.elements[1];
+
+	// The largest amount the basis can stretch a vector is at most
+	// sqrt(max(|x|^2, |y|^2) + |x.y|), which is exact for rotation and
+	// uniform scale, and still safe for non-uniform scale and skew.
+	fixed max_scale_squared = MAX(x_axis.length_squared(), y_axis.length_squared()) + x_axis.dot(y_axis).abs();
+	fixed max_scale = max_scale_squared.sqrt() + fixed::EPSILON;
+
+	// Pad the radius, so that rounding when transforming vertices and
+	// normalizing axes can never push the shape outside of its bounding circle.
+	fixed radius = bounding_radius * max_scale;
+	global_bounding_radius = radius + fixed(radius.value >> 7) + fixed(16);
+
+	// How much more the basis stretches along one axis than the other. Shapes
+	// that get transformed into another shape's local space need their radius
+	// multiplied by this. Negative means it's degenerate (or so stretched that
+	// the prefilter isn't worth it).
+	fixed determinant = t.basis_determinant().abs();
+	if (determinant > fixed::ZERO && max_scale_squared.value / 64 < determinant.value) {
+		global_bounding_stretch = (max_scale_squared + fixed::EPSILON) / determinant + fixed::EPSILON;
+	}
+	else {
+		global_bounding_stretch = fixed::NEG_ONE;
+	}
+
+	global_bounding_radius_dirty = false;
+}
+
 Vector<SGFixedVector2Internal> SGShape2DInternal::get_global_vertices() const {
 	return global_vertices;
 }
@@ -83,6 +114,23 @@ Vector<SGFixedVector2Internal> SGRectangle2DInternal::get_global_axes() const {
 	return global_axes;
 }
 
+void SGPolygon2DInternal::set_points(const Vector<SGFixedVector2Internal> &p_points) {
+	points = p_points;
+	global_vertices.clear();
+	global_axes.clear();
+	version++;
+
+	fixed max_length;
+	for (int i = 0; i < points.size(); i++) {
+		fixed length = points[i].length();
+		if (length > max_length) {
+			max_length = length;
+		}
+	}
+	// Add epsilon to make up for length() rounding down.
+	set_bounding_radius(max_length + fixed::EPSILON);
+}
+
 Vector<SGFixedVector2Internal> SGPolygon2DInternal::get_global_vertices() const {
 	if (global_vertices_dirty) {
 		SGFixedTransform2DInternal t = get_global_transform();
@@ -42,6 +42,7 @@ public:
 
 protected:
 	friend class SGCollisionObject2DInternal;
+	friend class SGTileGrid2DInternal;
 
 	ShapeType shape_type;
 	SGFixedTransform2DInternal transform;
@@ -49,14 +50,37 @@ protected:
 	mutable bool global_xform_dirty;
 	mutable bool global_vertices_dirty;
 	mutable bool global_axes_dirty;
+	mutable bool global_bounding_radius_dirty;
 	SGCollisionObject2DInternal *owner;
 	mutable Vector<SGFixedVector2Internal> global_vertices;
 	mutable Vector<SGFixedVector2Internal> global_axes;
 
+	// The radius of a circle around the shape's origin that contains the
+	// whole shape (in local space).
+	fixed bounding_radius;
+	mutable fixed global_bounding_radius;
+	mutable fixed global_bounding_stretch;
+
+	// Incremented whenever the shape's geometry changes, so that anything
+	// cached about it can be invalidated.
+	uint32_t version;
+
+	// Identifies the shape within its owner. Along with the owner's id, it's
+	// the same on every client, unlike the shape's address.
+	uint32_t index;
+
+	void update_global_bounding_radius() const;
+
 	_FORCE_INLINE_ void mark_global_xform_dirty() const {
 		global_xform_dirty = true;
 		global_vertices_dirty = true;
 		global_axes_dirty = true;
+		global_bounding_radius_dirty = true;
+	}
+
+	_FORCE_INLINE_ void set_bounding_radius(const fixed &p_bounding_radius) {
+		bounding_radius = p_bounding_radius;
+		global_bounding_radius_dirty = true;
 	}
 
 	_FORCE_INLINE_ void set_owner(SGCollisionObject2DInternal *p_owner) {
@@ -76,6 +100,23 @@ public:
 
 	_FORCE_INLINE_ SGCollisionObject2DInternal *get_owner() const { return owner; }
 
+	_FORCE_INLINE_ uint32_t get_version() const { return version; }
+	_FORCE_INLINE_ uint32_t get_index() const { return index; }
+
+	_FORCE_INLINE_ fixed get_bounding_radius() const { return bounding_radius; }
+	_FORCE_INLINE_ fixed get_global_bounding_radius() const {
+		if (global_bounding_radius_dirty) {
+			update_global_bounding_radius();
+		}
+		return global_bounding_radius;
+	}
+	_FORCE_INLINE_ fixed get_global_bounding_stretch() const {
+		if (global_bounding_radius_dirty) {
+			update_global_bounding_radius();
+		}
+		return global_bounding_stretch;
+	}
+
 	virtual Vector<SGFixedVector2Internal> get_global_vertices() const;
 	virtual Vector<SGFixedVector2Internal> get_global_axes() const;
 	virtual SGFixedRect2Internal get_bounds() const;
@@ -85,6 +126,9 @@ public:
 		global_xform_dirty = false;
 		global_vertices_dirty = true;
 		global_axes_dirty = true;
+		global_bounding_radius_dirty = true;
+		version = 0;
+		index = 0;
 		owner = nullptr;
 	}
 	virtual ~SGShape2DInternal() {}
@@ -100,6 +144,9 @@ public:
 	_FORCE_INLINE_ void set_extents(const SGFixedVector2Internal &p_extents) {
 		extents = p_extents;
 		global_vertices_dirty = true;
+		version++;
+		// Add epsilon to make up for length() rounding down.
+		set_bounding_radius(extents.length() + fixed::EPSILON);
 	}
 
 	virtual Vector<SGFixedVector2Internal> get_global_vertices() const override;
@@ -108,7 +155,7 @@ public:
 	SGRectangle2DInternal(SGFixedVector2Internal p_extents) 
 		: SGShape2DInternal(SHAPE_RECTANGLE) 
 	{
-		extents = p_extents;
+		set_extents(p_extents);
 		global_vertices.resize(4);
 		global_axes.resize(2);
 	}
@@ -123,14 +170,18 @@ protected:
 
 public:
 	_FORCE_INLINE_ fixed get_radius() const { return radius; }
-	_FORCE_INLINE_ void set_radius(const fixed &p_radius) { radius = p_radius; }
+	_FORCE_INLINE_ void set_radius(const fixed &p_radius) {
+		radius = p_radius;
+		version++;
+		set_bounding_radius(radius);
+	}
 
 	virtual SGFixedRect2Internal get_bounds() const override;
 
 	SGCircle2DInternal(fixed p_radius)
 		: SGShape2DInternal(SHAPE_CIRCLE)
 	{
-		radius = p_radius;
+		set_radius(p_radius);
 	}
 };
 
@@ -141,11 +192,7 @@ protected:
 
 public:
 	_FORCE_INLINE_ Vector<SGFixedVector2Internal> get_points() const { return points; } 
-	_FORCE_INLINE_ void set_points(const Vector<SGFixedVector2Internal> &p_points) {
-		points = p_points;
-		global_vertices.clear();
-		global_axes.clear();
-	}
+	void set_points(const Vector<SGFixedVector2Internal> &p_points);
 
 	virtual Vector<SGFixedVector2Internal> get_global_vertices() const override;
 	virtual Vector<SGFixedVector2Internal> get_global_axes() const override;
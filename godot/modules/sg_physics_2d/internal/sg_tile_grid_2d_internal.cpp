@@ -0,0 +1,187 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "sg_tile_grid_2d_internal.h"
+
+void SGTileGrid2DInternal::set_size(int p_width, int p_height) {
+	ERR_FAIL_COND(p_width < 0 || p_height < 0);
+
+	// Keep the cells that are still inside the grid.
+	Vector<uint32_t> old_cells = cells;
+	int old_width = width;
+	int old_height = height;
+
+	width = p_width;
+	height = p_height;
+	cells.resize(((int64_t)width * height + 31) / 32);
+	for (int i = 0; i < cells.size(); i++) {
+		cells.write[i] = 0;
+	}
+
+	int copy_width = MIN(width, old_width);
+	int copy_height = MIN(height, old_height);
+	for (int y = 0; y < copy_height; y++) {
+		for (int x = 0; x < copy_width; x++) {
+			int old_index = y * old_width + x;
+			if (old_cells[old_index >> 5] & (1U << (old_index & 31))) {
+				set_cell_solid(x, y, true);
+			}
+		}
+	}
+}
+
+void SGTileGrid2DInternal::set_cell_size(const SGFixedVector2Internal &p_cell_size) {
+	ERR_FAIL_COND(p_cell_size.x <= fixed::ZERO || p_cell_size.y <= fixed::ZERO);
+
+	cell_size = p_cell_size;
+}
+
+void SGTileGrid2DInternal::set_cell_solid(int p_x, int p_y, bool p_solid) {
+	ERR_FAIL_INDEX(p_x, width);
+	ERR_FAIL_INDEX(p_y, height);
+
+	int index = p_y * width + p_x;
+	if (p_solid) {
+		cells.write[index >> 5] |= (1U << (index & 31));
+	}
+	else {
+		cells.write[index >> 5] &= ~(1U << (index & 31));
+	}
+}
+
+void SGTileGrid2DInternal::clear() {
+	for (int i = 0; i < cells.size(); i++) {
+		cells.write[i] = 0;
+	}
+}
+
+void SGTileGrid2DInternal::set_cells(const Vector<uint32_t> &p_cells) {
+	ERR_FAIL_COND(p_cells.size() != cells.size());
+	cells = p_cells;
+}
+
+bool SGTileGrid2DInternal::get_cell_range(const SGFixedRect2Internal &p_rect, int &r_min_x, int &r_min_y, int &r_max_x, int &r_max_y) const {
+	if (width == 0 || height == 0) {
+		return false;
+	}
+
+	SGFixedVector2Internal origin = get_transform().get_origin();
+	SGFixedVector2Internal min = p_rect.get_min() - origin;
+	SGFixedVector2Internal max = p_rect.get_max() - origin;
+
+	r_min_x = MAX(floor_div(min.x.value, cell_size.x.value), 0);
+	r_min_y = MAX(floor_div(min.y.value, cell_size.y.value), 0);
+	r_max_x = MIN(floor_div(max.x.value, cell_size.x.value), width - 1);
+	r_max_y = MIN(floor_div(max.y.value, cell_size.y.value), height - 1);
+
+	return r_min_x <= r_max_x && r_min_y <= r_max_y;
+}
+
+// Returns floor((p_a * p_b) / p_c), without overflowing on the intermediate
+// product when 128-bit integers are available.
+static _FORCE_INLINE_ int64_t sg_muldiv_floor(int64_t p_a, int64_t p_b, int64_t p_c) {
+#ifdef SG_FIXED_WIDE_MATH
+	__int128 product = (__int128)p_a * p_b;
+	__int128 result = product / p_c;
+	if ((product % p_c != 0) && ((product < 0) != (p_c < 0))) {
+		result--;
+	}
+	return (int64_t)result;
+#else
+	int64_t product = p_a * p_b;
+	int64_t result = product / p_c;
+	if ((product % p_c != 0) && ((product < 0) != (p_c < 0))) {
+		result--;
+	}
+	return result;
+#endif
+}
+
+bool SGTileGrid2DInternal::get_segment_row_range(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, int p_x, int &r_min_y, int &r_max_y) const {
+	if (height == 0) {
+		return false;
+	}
+
+	// Everything is done on the raw values, relative to the grid's origin.
+	SGFixedVector2Internal start = p_start - get_transform().get_origin();
+	int64_t start_x = start.x.value;
+	int64_t start_y = start.y.value;
+	int64_t cast_x = p_cast_to.x.value;
+	int64_t cast_y = p_cast_to.y.value;
+
+	// Clip the segment to the column.
+	int64_t column_min_x = cell_size.x.value * p_x;
+	int64_t column_max_x = column_min_x + cell_size.x.value;
+	int64_t min_x = MAX(column_min_x, MIN(start_x, start_x + cast_x));
+	int64_t max_x = MIN(column_max_x, MAX(start_x, start_x + cast_x));
+	if (min_x > max_x) {
+		return false;
+	}
+
+	// Then find its y at both ends of the clipped part. The y is rounded
+	// down, which puts it in the same row as the exact value would be.
+	int64_t y1 = start_y;
+	int64_t y2 = start_y + cast_y;
+	if (cast_x != 0) {
+		y1 = start_y + sg_muldiv_floor(min_x - start_x, cast_y, cast_x);
+		y2 = start_y + sg_muldiv_floor(max_x - start_x, cast_y, cast_x);
+	}
+
+	r_min_y = MAX(floor_div(MIN(y1, y2), cell_size.y.value), 0);
+	r_max_y = MIN(floor_div(MAX(y1, y2), cell_size.y.value), height - 1);
+	return r_min_y <= r_max_y;
+}
+
+SGRectangle2DInternal SGTileGrid2DInternal::create_tile_shape() const {
+	SGRectangle2DInternal shape(cell_size / fixed::TWO);
+	// It's positioned relative to the grid, and keyed by the grid's id in the
+	// separating axis cache, but never added to its shapes.
+	shape.set_owner(const_cast<SGTileGrid2DInternal *>(this));
+	return shape;
+}
+
+void SGTileGrid2DInternal::set_tile_shape_cell(SGRectangle2DInternal &r_shape, int p_x, int p_y) const {
+	SGFixedTransform2DInternal t;
+	t.set_origin(SGFixedVector2Internal(
+		fixed(cell_size.x.value * p_x),
+		fixed(cell_size.y.value * p_y)) + r_shape.get_extents());
+	r_shape.set_transform(t);
+	r_shape.index = p_y * width + p_x;
+}
+
+SGFixedRect2Internal SGTileGrid2DInternal::get_grid_bounds() const {
+	return SGFixedRect2Internal(get_transform().get_origin(), SGFixedVector2Internal(
+		fixed(cell_size.x.value * width),
+		fixed(cell_size.y.value * height)));
+}
+
+SGTileGrid2DInternal::SGTileGrid2DInternal()
+	: SGBody2DInternal(BODY_TILE_GRID)
+{
+	width = 0;
+	height = 0;
+	cell_size = SGFixedVector2Internal(64_fx, 64_fx);
+}
+
+SGTileGrid2DInternal::~SGTileGrid2DInternal() {
+}
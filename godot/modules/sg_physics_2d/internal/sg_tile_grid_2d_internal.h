@@ -0,0 +1,93 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SG_TILE_GRID_2D_INTERNAL_H
+#define SG_TILE_GRID_2D_INTERNAL_H
+
+#include <core/vector.h>
+
+#include "sg_bodies_2d_internal.h"
+#include "sg_shapes_2d_internal.h"
+
+// A static body made up of solid, axis-aligned tiles. Rather than having a
+// shape for each tile, the tiles are stored in a bitset, and the world tests
+// against them one at a time, moving a rectangle shape from cell to cell.
+//
+// Only the origin of the transform is used: the grid can't be rotated or
+// scaled.
+class SGTileGrid2DInternal : public SGBody2DInternal {
+	int width;
+	int height;
+	SGFixedVector2Internal cell_size;
+	Vector<uint32_t> cells;
+
+	_FORCE_INLINE_ static int floor_div(int64_t p_value, int64_t p_divisor) {
+		int64_t result = p_value / p_divisor;
+		if ((p_value % p_divisor != 0) && ((p_value < 0) != (p_divisor < 0))) {
+			result--;
+		}
+		return (int)CLAMP(result, (int64_t)INT32_MIN, (int64_t)INT32_MAX);
+	}
+
+public:
+	_FORCE_INLINE_ int get_width() const { return width; }
+	_FORCE_INLINE_ int get_height() const { return height; }
+	void set_size(int p_width, int p_height);
+
+	_FORCE_INLINE_ SGFixedVector2Internal get_cell_size() const { return cell_size; }
+	void set_cell_size(const SGFixedVector2Internal &p_cell_size);
+
+	_FORCE_INLINE_ bool is_cell_solid(int p_x, int p_y) const {
+		if (p_x < 0 || p_y < 0 || p_x >= width || p_y >= height) {
+			return false;
+		}
+		int index = p_y * width + p_x;
+		return cells[index >> 5] & (1U << (index & 31));
+	}
+	void set_cell_solid(int p_x, int p_y, bool p_solid);
+	void clear();
+
+	_FORCE_INLINE_ const Vector<uint32_t> &get_cells() const { return cells; }
+	void set_cells(const Vector<uint32_t> &p_cells);
+
+	// Gets the range of cells (inclusive) touched by the given rectangle.
+	// Returns false if the rectangle doesn't touch the grid at all.
+	bool get_cell_range(const SGFixedRect2Internal &p_rect, int &r_min_x, int &r_min_y, int &r_max_x, int &r_max_y) const;
+
+	// Gets the rows (inclusive) of column p_x that the given segment passes
+	// through. Returns false if it doesn't pass through that column at all.
+	bool get_segment_row_range(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, int p_x, int &r_min_y, int &r_max_y) const;
+
+	// Makes a rectangle the size of a cell, to be moved from cell to cell
+	// with set_tile_shape_cell(). Nothing about it is shared with the grid,
+	// so each query can make its own, and queries can run at the same time.
+	SGRectangle2DInternal create_tile_shape() const;
+	void set_tile_shape_cell(SGRectangle2DInternal &r_shape, int p_x, int p_y) const;
+
+	SGFixedRect2Internal get_grid_bounds() const;
+
+	SGTileGrid2DInternal();
+	~SGTileGrid2DInternal();
+};
+
+#endif
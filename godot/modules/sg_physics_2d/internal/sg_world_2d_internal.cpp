@@ -26,16 +26,11 @@
 #include <core/project_settings.h>
 
 #include "sg_bodies_2d_internal.h"
+#include "sg_tile_grid_2d_internal.h"
 #include "sg_shapes_2d_internal.h"
 #include "sg_broadphase_2d_internal.h"
 #include "sg_collision_detector_2d_internal.h"
 
-SGWorld2DInternal *SGWorld2DInternal::singleton = NULL;
-
-SGWorld2DInternal *SGWorld2DInternal::get_singleton() {
-	return singleton;
-}
-
 void SGWorld2DInternal::add_area(SGArea2DInternal *p_area) {
 	areas.push_back(p_area);
 	p_area->add_to_broadphase(broadphase);
@@ -44,6 +39,7 @@ void SGWorld2DInternal::add_area(SGArea2DInternal *p_area) {
 void SGWorld2DInternal::remove_area(SGArea2DInternal *p_area) {
 	areas.erase(p_area);
 	p_area->remove_from_broadphase();
+	clear_separating_axis_cache(p_area);
 }
 
 void SGWorld2DInternal::add_body(SGBody2DInternal *p_body) {
@@ -54,9 +50,61 @@ void SGWorld2DInternal::add_body(SGBody2DInternal *p_body) {
 void SGWorld2DInternal::remove_body(SGBody2DInternal *p_body) {
 	bodies.erase(p_body);
 	p_body->remove_from_broadphase();
+	clear_separating_axis_cache(p_body);
+}
+
+void SGWorld2DInternal::add_tile_grid(SGTileGrid2DInternal *p_tile_grid) {
+	// Tile grids don't go in the broadphase: we can find the tiles touching
+	// an object directly from its bounds.
+	tile_grids.push_back(p_tile_grid);
+}
+
+void SGWorld2DInternal::remove_tile_grid(SGTileGrid2DInternal *p_tile_grid) {
+	tile_grids.erase(p_tile_grid);
+}
+
+void SGWorld2DInternal::begin_batch_update() {
+	broadphase->begin_batch();
+}
+
+void SGWorld2DInternal::end_batch_update() {
+	broadphase->end_batch();
+}
+
+bool SGWorld2DInternal::is_tile_grid(const SGCollisionObject2DInternal *p_object) {
+	return p_object->get_object_type() == SGCollisionObject2DInternal::OBJECT_BODY &&
+		((const SGBody2DInternal *)p_object)->get_body_type() == SGBody2DInternal::BODY_TILE_GRID;
+}
+
+void SGWorld2DInternal::find_nearby_tile_grids(const SGFixedRect2Internal &p_bounds, SGResultHandlerInternal *p_result_handler) const {
+	for (const List<SGTileGrid2DInternal *>::Element *E = tile_grids.front(); E; E = E->next()) {
+		if (E->get()->get_grid_bounds().intersects(p_bounds)) {
+			p_result_handler->handle_result(E->get());
+		}
+	}
+}
+
+void SGWorld2DInternal::clear_separating_axis_cache(const SGCollisionObject2DInternal *p_object) {
+	uint64_t id = p_object->get_id();
+	for (int i = 0; i < SEPARATING_AXIS_CACHE_SIZE; i++) {
+		SeparatingAxisCacheEntry &entry = separating_axis_cache[i];
+		if (entry.object_id1 == id || entry.object_id2 == id) {
+			entry.axis = -1;
+		}
+	}
+}
+
+void SGWorld2DInternal::reset_process_info() {
+	prefilter_test_count = 0;
+	prefilter_rejection_count = 0;
+	separating_axis_cache_hit_count = 0;
 }
 
 bool SGWorld2DInternal::overlaps(SGCollisionObject2DInternal *p_object1, SGCollisionObject2DInternal *p_object2, SGWorld2DInternal::BodyOverlapInfo *p_info) const {
+	if (is_tile_grid(p_object2)) {
+		return overlaps_tile_grid(p_object1, (SGTileGrid2DInternal *)p_object2, p_info);
+	}
+
 	bool overlapping = false;
 
 	SGWorld2DInternal::ShapeOverlapInfo shape_overlap_info;
@@ -85,20 +133,86 @@ bool SGWorld2DInternal::overlaps(SGCollisionObject2DInternal *p_object1, SGColli
 	return overlapping;
 }
 
+bool SGWorld2DInternal::overlaps_tile_grid(SGCollisionObject2DInternal *p_object, SGTileGrid2DInternal *p_tile_grid, SGWorld2DInternal::BodyOverlapInfo *p_info) const {
+	bool overlapping = false;
+
+	SGWorld2DInternal::ShapeOverlapInfo shape_overlap_info;
+	fixed longest_separation_squared = -fixed::HALF;
+	SGRectangle2DInternal tile_shape = p_tile_grid->create_tile_shape();
+
+	for (const List<SGShape2DInternal *>::Element *S = p_object->get_shapes().front(); S; S = S->next()) {
+		int min_x, min_y, max_x, max_y;
+		if (!p_tile_grid->get_cell_range(S->get()->get_bounds(), min_x, min_y, max_x, max_y)) {
+			continue;
+		}
+
+		for (int y = min_y; y <= max_y; y++) {
+			for (int x = min_x; x <= max_x; x++) {
+				if (!p_tile_grid->is_cell_solid(x, y)) {
+					continue;
+				}
+
+				p_tile_grid->set_tile_shape_cell(tile_shape, x, y);
+				if (overlaps(S->get(), &tile_shape, &shape_overlap_info)) {
+					overlapping = true;
+					if (!p_info) {
+						return overlapping;
+					}
+
+					fixed separation_length_squared = shape_overlap_info.separation.length_squared();
+					if (separation_length_squared > longest_separation_squared) {
+						longest_separation_squared = separation_length_squared;
+						p_info->collider = p_tile_grid;
+						p_info->collider_shape = nullptr;
+						p_info->local_shape = S->get();
+						p_info->separation = shape_overlap_info.separation;
+					}
+				}
+			}
+		}
+	}
+
+	return overlapping;
+}
+
+static _FORCE_INLINE_ uint64_t sg_get_shape_owner_id(const SGShape2DInternal *p_shape) {
+	return p_shape->get_owner() ? p_shape->get_owner()->get_id() : 0;
+}
+
 bool SGWorld2DInternal::overlaps(SGShape2DInternal *p_shape1, SGShape2DInternal *p_shape2, SGWorld2DInternal::ShapeOverlapInfo *p_info) const {
 	using ShapeType = SGShape2DInternal::ShapeType;
 
 	ShapeType shape1_type = p_shape1->get_shape_type();
 	ShapeType shape2_type = p_shape2->get_shape_type();
 
+	// Most candidates from the broadphase don't overlap, so do a cheap test
+	// before doing the full narrowphase.
+	prefilter_test_count++;
+	if (!SGCollisionDetector2DInternal::bounding_circles_overlap(*p_shape1, *p_shape2)) {
+		prefilter_rejection_count++;
+		return false;
+	}
+
 	SGCollisionDetector2DInternal::OverlapInfo overlap_info;
 	SGCollisionDetector2DInternal::OverlapInfo *overlap_info_ptr = p_info ? &overlap_info : nullptr;
 
+	uint64_t object_id1 = sg_get_shape_owner_id(p_shape1);
+	uint64_t object_id2 = sg_get_shape_owner_id(p_shape2);
+	uint32_t shape_index1 = p_shape1->get_index();
+	uint32_t shape_index2 = p_shape2->get_index();
+	SeparatingAxisCacheEntry &cache_entry = get_separating_axis_cache_entry(object_id1, shape_index1, object_id2, shape_index2);
+	int axis_hint = -1;
+	if (cache_entry.object_id1 == object_id1 && cache_entry.object_id2 == object_id2 && cache_entry.shape_index1 == shape_index1 && cache_entry.shape_index2 == shape_index2 &&
+			cache_entry.version1 == p_shape1->get_version() && cache_entry.version2 == p_shape2->get_version()) {
+		axis_hint = cache_entry.axis;
+	}
+	const int cached_axis_hint = axis_hint;
+
 	bool overlapping = false;
 	bool swap = false;
 
 	if (shape1_type == ShapeType::SHAPE_RECTANGLE && shape2_type == ShapeType::SHAPE_RECTANGLE) {
-		overlapping = SGCollisionDetector2DInternal::Rectangle_overlaps_Rectangle(*((SGRectangle2DInternal *)p_shape1), *((SGRectangle2DInternal *)p_shape2), overlap_info_ptr);
+		overlapping = SGCollisionDetector2DInternal::Rectangle_overlaps_Rectangle(*((SGRectangle2DInternal *)p_shape1), *((SGRectangle2DInternal *)p_shape2), overlap_info_ptr, &axis_hint);
 	}
 	else if (shape1_type == ShapeType::SHAPE_CIRCLE && shape2_type == ShapeType::SHAPE_CIRCLE) {
 		overlapping = SGCollisionDetector2DInternal::Circle_overlaps_Circle(*((SGCircle2DInternal *)p_shape1), *((SGCircle2DInternal *)p_shape2), overlap_info_ptr);
@@ -111,23 +225,36 @@ bool SGWorld2DInternal::overlaps(SGShape2DInternal *p_shape1, SGShape2DInternal
 		swap = true;
 	}
 	else if (shape1_type == ShapeType::SHAPE_POLYGON && shape2_type == ShapeType::SHAPE_POLYGON) {
-		overlapping = SGCollisionDetector2DInternal::Polygon_overlaps_Polygon(*((SGPolygon2DInternal *)p_shape1), *((SGPolygon2DInternal *)p_shape2), overlap_info_ptr);
+		overlapping = SGCollisionDetector2DInternal::Polygon_overlaps_Polygon(*((SGPolygon2DInternal *)p_shape1), *((SGPolygon2DInternal *)p_shape2), overlap_info_ptr, &axis_hint);
 	}
 	else if (shape1_type == ShapeType::SHAPE_POLYGON && shape2_type == ShapeType::SHAPE_CIRCLE) {
-		overlapping = SGCollisionDetector2DInternal::Polygon_overlaps_Circle(*((SGPolygon2DInternal *)p_shape1), *((SGCircle2DInternal *)p_shape2), overlap_info_ptr);
+		overlapping = SGCollisionDetector2DInternal::Polygon_overlaps_Circle(*((SGPolygon2DInternal *)p_shape1), *((SGCircle2DInternal *)p_shape2), overlap_info_ptr, &axis_hint);
 	}
 	else if (shape1_type == ShapeType::SHAPE_CIRCLE && shape2_type == ShapeType::SHAPE_POLYGON) {
-		overlapping = SGCollisionDetector2DInternal::Polygon_overlaps_Circle(*((SGPolygon2DInternal *)p_shape2), *((SGCircle2DInternal *)p_shape1), overlap_info_ptr);
+		overlapping = SGCollisionDetector2DInternal::Polygon_overlaps_Circle(*((SGPolygon2DInternal *)p_shape2), *((SGCircle2DInternal *)p_shape1), overlap_info_ptr, &axis_hint);
 		swap = true;
 	}
 	else if (shape1_type == ShapeType::SHAPE_POLYGON && shape2_type == ShapeType::SHAPE_RECTANGLE) {
-		overlapping = SGCollisionDetector2DInternal::Polygon_overlaps_Rectangle(*((SGPolygon2DInternal *)p_shape1), *((SGRectangle2DInternal *)p_shape2), overlap_info_ptr);
+		overlapping = SGCollisionDetector2DInternal::Polygon_overlaps_Rectangle(*((SGPolygon2DInternal *)p_shape1), *((SGRectangle2DInternal *)p_shape2), overlap_info_ptr, &axis_hint);
 	}
 	else if (shape1_type == ShapeType::SHAPE_RECTANGLE && shape2_type == ShapeType::SHAPE_POLYGON) {
-		overlapping = SGCollisionDetector2DInternal::Polygon_overlaps_Rectangle(*((SGPolygon2DInternal *)p_shape2), *((SGRectangle2DInternal *)p_shape1), overlap_info_ptr);
+		overlapping = SGCollisionDetector2DInternal::Polygon_overlaps_Rectangle(*((SGPolygon2DInternal *)p_shape2), *((SGRectangle2DInternal *)p_shape1), overlap_info_ptr, &axis_hint);
 		swap = true;
 	}
 
+	if (!overlapping && axis_hint != -1) {
+		if (axis_hint == cached_axis_hint) {
+			separating_axis_cache_hit_count++;
+		}
+		cache_entry.object_id1 = object_id1;
+		cache_entry.object_id2 = object_id2;
+		cache_entry.shape_index1 = shape_index1;
+		cache_entry.shape_index2 = shape_index2;
+		cache_entry.version1 = p_shape1->get_version();
+		cache_entry.version2 = p_shape2->get_version();
+		cache_entry.axis = axis_hint;
+	}
+
 	if (overlapping && p_info) {
 		// Make sure the info is from the perspective of the first shape.
 		p_info->shape = p_shape2;
@@ -188,10 +315,273 @@ public:
 
 bool SGWorld2DInternal::get_best_overlapping_body(SGCollisionObject2DInternal *p_object, SGWorld2DInternal::BodyOverlapInfo *p_info, SGWorld2DInternal::CompareCallback p_compare) const {
 	SGBestOverlappingResultHandler result_handler(this, p_object, p_info, p_compare);
-	broadphase->find_nearby(p_object->get_bounds(), &result_handler, SGCollisionObject2DInternal::OBJECT_BODY);
+	SGFixedRect2Internal bounds = p_object->get_bounds();
+	broadphase->find_nearby(bounds, &result_handler, SGCollisionObject2DInternal::OBJECT_BODY);
+	find_nearby_tile_grids(bounds, &result_handler);
+	return result_handler.is_overlapping();
+}
+
+bool SGWorld2DInternal::get_best_overlapping_body(SGCollisionObject2DInternal *p_object, const Vector<SGCollisionObject2DInternal *> &p_candidates, SGWorld2DInternal::BodyOverlapInfo *p_info, SGWorld2DInternal::CompareCallback p_compare) const {
+	SGBestOverlappingResultHandler result_handler(this, p_object, p_info, p_compare);
+	for (int i = 0; i < p_candidates.size(); i++) {
+		result_handler.handle_result(p_candidates[i]);
+	}
 	return result_handler.is_overlapping();
 }
 
+class SGMotionCandidatesResultHandler : public SGResultHandlerInternal {
+private:
+
+	SGCollisionObject2DInternal *object;
+	Vector<SGCollisionObject2DInternal *> &candidates;
+
+public:
+
+	void handle_result(SGCollisionObject2DInternal *p_object) {
+		if (object == p_object) {
+			return;
+		}
+
+		if (!object->test_collision_layers(p_object)) {
+			return;
+		}
+
+		candidates.push_back(p_object);
+	}
+
+	_FORCE_INLINE_ SGMotionCandidatesResultHandler(SGCollisionObject2DInternal *p_object, Vector<SGCollisionObject2DInternal *> &p_candidates)
+		: object(p_object), candidates(p_candidates) { }
+
+};
+
+void SGWorld2DInternal::get_motion_candidates(SGCollisionObject2DInternal *p_object, const SGFixedVector2Internal &p_motion, Vector<SGCollisionObject2DInternal *> &p_candidates) const {
+	p_candidates.clear();
+
+	SGFixedRect2Internal bounds = p_object->get_bounds();
+	bounds = bounds.merge(SGFixedRect2Internal(bounds.position + p_motion, bounds.size));
+
+	SGMotionCandidatesResultHandler result_handler(p_object, p_candidates);
+	broadphase->find_nearby(bounds, &result_handler, SGCollisionObject2DInternal::OBJECT_BODY);
+	find_nearby_tile_grids(bounds, &result_handler);
+}
+
+// Sweeps the first shape along the motion until it touches the second one,
+// picking the right test for the shape types. Neither shape should be
+// overlapping the other at the start.
+static bool sg_sweep_shape(const SGShape2DInternal &p_shape1, const SGShape2DInternal &p_shape2, const SGFixedVector2Internal &p_motion, fixed &r_time, SGCollisionDetector2DInternal::ImpactInfo *p_info = nullptr) {
+	using ShapeType = SGShape2DInternal::ShapeType;
+
+	if (p_shape1.get_shape_type() == ShapeType::SHAPE_CIRCLE) {
+		return SGCollisionDetector2DInternal::Circle_time_of_impact((const SGCircle2DInternal &)p_shape1, p_shape2, p_motion, r_time, p_info);
+	}
+
+	if (p_shape2.get_shape_type() == ShapeType::SHAPE_CIRCLE) {
+		// Sweep the circle backwards instead, and then move the point to
+		// where it would be from the perspective of the first shape.
+		if (!SGCollisionDetector2DInternal::Circle_time_of_impact((const SGCircle2DInternal &)p_shape2, p_shape1, -p_motion, r_time, p_info)) {
+			return false;
+		}
+		if (p_info) {
+			p_info->normal = -p_info->normal;
+			p_info->point += p_motion * r_time;
+		}
+		return true;
+	}
+
+	return SGCollisionDetector2DInternal::Polygon_time_of_impact(p_shape1, p_shape2, p_motion, r_time, p_info);
+}
+
+bool SGWorld2DInternal::get_time_of_impact(SGCollisionObject2DInternal *p_object, const SGFixedVector2Internal &p_motion, const Vector<SGCollisionObject2DInternal *> &p_candidates, fixed &r_time) const {
+	bool hit = false;
+	fixed time;
+
+	for (const List<SGShape2DInternal *>::Element *S1 = p_object->get_shapes().front(); S1; S1 = S1->next()) {
+		for (int i = 0; i < p_candidates.size(); i++) {
+			SGCollisionObject2DInternal *candidate = p_candidates[i];
+
+			if (is_tile_grid(candidate)) {
+				SGTileGrid2DInternal *tile_grid = (SGTileGrid2DInternal *)candidate;
+
+				SGFixedRect2Internal bounds = S1->get()->get_bounds();
+				bounds = bounds.merge(SGFixedRect2Internal(bounds.position + p_motion, bounds.size));
+
+				int min_x, min_y, max_x, max_y;
+				if (!tile_grid->get_cell_range(bounds, min_x, min_y, max_x, max_y)) {
+					continue;
+				}
+
+				SGRectangle2DInternal tile_shape = tile_grid->create_tile_shape();
+				for (int y = min_y; y <= max_y; y++) {
+					for (int x = min_x; x <= max_x; x++) {
+						if (!tile_grid->is_cell_solid(x, y)) {
+							continue;
+						}
+
+						tile_grid->set_tile_shape_cell(tile_shape, x, y);
+						if (sg_sweep_shape(*S1->get(), tile_shape, p_motion, time)) {
+							if (!hit || time < r_time) {
+								r_time = time;
+								hit = true;
+							}
+						}
+					}
+				}
+
+				continue;
+			}
+
+			for (const List<SGShape2DInternal *>::Element *S2 = candidate->get_shapes().front(); S2; S2 = S2->next()) {
+				if (sg_sweep_shape(*S1->get(), *S2->get(), p_motion, time)) {
+					if (!hit || time < r_time) {
+						r_time = time;
+						hit = true;
+					}
+				}
+			}
+		}
+	}
+
+	return hit;
+}
+
+// Moves the object to a fraction of the motion, without updating the
+// broadphase, and tests it against the candidates.
+static bool sg_test_motion(const SGWorld2DInternal *p_world, SGCollisionObject2DInternal *p_object, const SGFixedTransform2DInternal &p_transform, const SGFixedVector2Internal &p_motion, fixed p_fraction, const Vector<SGCollisionObject2DInternal *> &p_candidates, SGWorld2DInternal::BodyOverlapInfo *p_info, SGWorld2DInternal::CompareCallback p_compare) {
+	SGFixedTransform2DInternal test_transform = p_transform;
+	test_transform.set_origin(p_transform.get_origin() + (p_motion * p_fraction));
+	p_object->set_transform(test_transform, false);
+	return p_world->get_best_overlapping_body(p_object, p_candidates, p_info, p_compare);
+}
+
+bool SGWorld2DInternal::move_and_collide(SGCollisionObject2DInternal *p_object, const SGFixedVector2Internal &p_motion, MotionCollision *p_collision, CompareCallback p_compare) {
+	BodyOverlapInfo overlap_info;
+
+	// Get everything we could hit along the way with a single broadphase
+	// query, so that none of the tests below need to query it again.
+	Vector<SGCollisionObject2DInternal *> candidates;
+	get_motion_candidates(p_object, p_motion, candidates);
+
+	// First, get our body unstuck, if it's stuck.
+	bool stuck = get_best_overlapping_body(p_object, candidates, &overlap_info, p_compare);
+	if (stuck) {
+		for (int i = 0; i < 4; i++) {
+			SGFixedTransform2DInternal t = p_object->get_transform();
+			t.set_origin(t.get_origin() + overlap_info.separation);
+			p_object->set_transform(t);
+
+			stuck = get_best_overlapping_body(p_object, &overlap_info, p_compare);
+			if (!stuck) {
+				break;
+			}
+		}
+		if (!stuck) {
+			// We've moved, so the candidates may be out-of-date.
+			get_motion_candidates(p_object, p_motion, candidates);
+		}
+	}
+	if (stuck) {
+		// We can't really continue. Bail with some sort of reasonable values.
+		p_collision->collider = overlap_info.collider;
+		p_collision->normal = SGFixedVector2Internal::ZERO;
+		p_collision->remainder = p_motion;
+		return true;
+	}
+
+	// Move the body the full amount.
+	SGFixedTransform2DInternal original_transform = p_object->get_transform();
+	SGFixedTransform2DInternal test_transform = original_transform;
+	test_transform.set_origin(original_transform.get_origin() + p_motion);
+
+	// Check if we're colliding. If not, we're done.
+	if (!sg_test_motion(this, p_object, original_transform, p_motion, fixed::ONE, candidates, &overlap_info, p_compare)) {
+		p_object->set_transform(test_transform);
+		return false;
+	}
+	BodyOverlapInfo destination_overlap_info = overlap_info;
+
+	fixed low = fixed::ZERO;
+	fixed hi = fixed::ONE;
+	bool found = false;
+
+	// Work out when we first touch something directly. Rounding can put the
+	// result off by a little, so make sure we're touching at 'hi' but not at
+	// the step before it.
+	fixed time;
+	p_object->set_transform(original_transform, false);
+	if (get_time_of_impact(p_object, p_motion, candidates, time)) {
+		BodyOverlapInfo low_overlap_info;
+		if (time < fixed::EPSILON) {
+			time = fixed::EPSILON;
+		}
+		for (int i = 0; i < 3; i++) {
+			fixed cur = time + fixed(i);
+			if (cur > fixed::ONE) {
+				break;
+			}
+			if (sg_test_motion(this, p_object, original_transform, p_motion, cur, candidates, &overlap_info, p_compare)) {
+				if (!sg_test_motion(this, p_object, original_transform, p_motion, cur - fixed::EPSILON, candidates, &low_overlap_info, p_compare)) {
+					low = cur - fixed::EPSILON;
+					hi = cur;
+					found = true;
+				}
+				break;
+			}
+		}
+	}
+
+	// Otherwise, fallback on using binary search to find the point at which
+	// we collide, and the point just before that.
+	if (!found) {
+		BodyOverlapInfo test_overlap_info;
+		overlap_info = destination_overlap_info;
+		for (int i = 0; i < 8; i++) {
+			fixed cur = (low + hi) * fixed::HALF;
+			if (sg_test_motion(this, p_object, original_transform, p_motion, cur, candidates, &test_overlap_info, p_compare)) {
+				hi = cur;
+				overlap_info = test_overlap_info;
+			}
+			else {
+				low = cur;
+			}
+		}
+	}
+
+	// Put the object at the safe position, and update the broadphase, since
+	// none of the tests did that.
+	test_transform.set_origin(original_transform.get_origin() + (p_motion * low));
+	p_object->set_transform(test_transform);
+
+	// The overlap_info has the collision at 'hi', which is what we report.
+	p_collision->collider = overlap_info.collider;
+	p_collision->normal = overlap_info.separation.normalized();
+	p_collision->remainder = p_motion - (p_motion * low);
+
+	return true;
+}
+
+SGFixedVector2Internal SGWorld2DInternal::move_and_slide(SGCollisionObject2DInternal *p_object, const SGFixedVector2Internal &p_motion, int p_max_slides, CompareCallback p_compare) {
+	SGFixedVector2Internal motion = p_motion;
+
+	while (p_max_slides) {
+		MotionCollision collision;
+
+		if (!move_and_collide(p_object, motion, &collision, p_compare)) {
+			// No collision, so we're good - bail!
+			break;
+		}
+		motion = collision.remainder.slide(collision.normal);
+
+		if (motion == SGFixedVector2Internal::ZERO) {
+			// No remaining motion, so we're good - bail!
+			break;
+		}
+
+		p_max_slides--;
+	}
+
+	return motion;
+}
+
 class SGOverlappingResultHandler : public SGResultHandlerInternal {
 private:
 
@@ -227,7 +617,9 @@ void SGWorld2DInternal::get_overlapping_areas(SGCollisionObject2DInternal *p_obj
 
 void SGWorld2DInternal::get_overlapping_bodies(SGCollisionObject2DInternal *p_object, SGResultHandlerInternal *p_result_handler) const {
 	SGOverlappingResultHandler overlapping_handler(this, p_object, p_result_handler);
-	broadphase->find_nearby(p_object->get_bounds(), &overlapping_handler, SGCollisionObject2DInternal::OBJECT_BODY);
+	SGFixedRect2Internal bounds = p_object->get_bounds();
+	broadphase->find_nearby(bounds, &overlapping_handler, SGCollisionObject2DInternal::OBJECT_BODY);
+	find_nearby_tile_grids(bounds, &overlapping_handler);
 }
 
 bool SGWorld2DInternal::segment_intersects_shape(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, SGShape2DInternal *p_shape, SGFixedVector2Internal &p_intersection_point, SGFixedVector2Internal &p_collision_normal) const {
@@ -248,6 +640,59 @@ bool SGWorld2DInternal::segment_intersects_shape(const SGFixedVector2Internal &p
 	return false;
 }
 
+bool SGWorld2DInternal::segment_intersects_tile_grid(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, SGTileGrid2DInternal *p_tile_grid, SGFixedVector2Internal &p_intersection_point, SGFixedVector2Internal &p_collision_normal) const {
+	SGFixedRect2Internal bounds(p_start, SGFixedVector2Internal());
+	bounds.expand_to(p_start + p_cast_to);
+
+	int min_x, min_y, max_x, max_y;
+	if (!p_tile_grid->get_cell_range(bounds, min_x, min_y, max_x, max_y)) {
+		return false;
+	}
+
+	// Walk the columns in the direction of the ray, so that the first column
+	// with an intersection has the closest one.
+	int step = (p_cast_to.x < fixed::ZERO) ? -1 : 1;
+	int first_x = (step > 0) ? min_x : max_x;
+	int last_x = (step > 0) ? max_x : min_x;
+
+	bool intersects = false;
+	fixed shortest_distance_squared;
+	SGFixedVector2Internal intersection_point;
+	SGFixedVector2Internal collision_normal;
+	SGRectangle2DInternal tile_shape = p_tile_grid->create_tile_shape();
+
+	for (int x = first_x; x != last_x + step; x += step) {
+		// Only check the rows the segment actually passes through in this
+		// column.
+		int column_min_y, column_max_y;
+		if (!p_tile_grid->get_segment_row_range(p_start, p_cast_to, x, column_min_y, column_max_y)) {
+			continue;
+		}
+
+		for (int y = column_min_y; y <= column_max_y; y++) {
+			if (!p_tile_grid->is_cell_solid(x, y)) {
+				continue;
+			}
+			p_tile_grid->set_tile_shape_cell(tile_shape, x, y);
+			if (segment_intersects_shape(p_start, p_cast_to, &tile_shape, intersection_point, collision_normal)) {
+				fixed distance_squared = (intersection_point - p_start).length_squared();
+				if (!intersects || distance_squared < shortest_distance_squared) {
+					intersects = true;
+					shortest_distance_squared = distance_squared;
+					p_intersection_point = intersection_point;
+					p_collision_normal = collision_normal;
+				}
+			}
+		}
+
+		if (intersects) {
+			break;
+		}
+	}
+
+	return intersects;
+}
+
 class SGRayCastResultHandler : public SGResultHandlerInternal {
 private:
 
@@ -276,22 +721,35 @@ public:
 			return;
 		}
 
+		if (SGWorld2DInternal::is_tile_grid(p_object)) {
+			if (world->segment_intersects_tile_grid(start, cast_to, (SGTileGrid2DInternal *)p_object, intersection_point, collision_normal)) {
+				handle_intersection(p_object);
+			}
+			return;
+		}
+
 		for (const List<SGShape2DInternal *>::Element *S = p_object->get_shapes().front(); S; S = S->next()) {
 			SGShape2DInternal *shape = S->get();
 			if (world->segment_intersects_shape(start, cast_to, shape, intersection_point, collision_normal)) {
-				intersects = true;
-
-				fixed distance_squared = (intersection_point - start).length_squared();
-				if (collider == nullptr || distance_squared < shortest_distance_squared) {
-					shortest_distance_squared = distance_squared;
-					collider = p_object;
-					closest_intersection_point = intersection_point;
-					closest_collision_normal = collision_normal;
-				}
+				handle_intersection(p_object);
 			}
 		}
 	}
 
+	_FORCE_INLINE_ void handle_intersection(SGCollisionObject2DInternal *p_object) {
+		intersects = true;
+
+		// Hits at the same distance go to the lowest id, rather than whichever
+		// the broadphase happened to return first.
+		fixed distance_squared = (intersection_point - start).length_squared();
+		if (collider == nullptr || distance_squared < shortest_distance_squared || (distance_squared == shortest_distance_squared && p_object->get_id() < collider->get_id())) {
+			shortest_distance_squared = distance_squared;
+			collider = p_object;
+			closest_intersection_point = intersection_point;
+			closest_collision_normal = collision_normal;
+		}
+	}
+
 	_FORCE_INLINE_ void populate_info(SGWorld2DInternal::RayCastInfo *p_info) {
 		if (collider) {
 			p_info->body = (SGBody2DInternal *)collider;
@@ -319,12 +777,280 @@ bool SGWorld2DInternal::cast_ray(const SGFixedVector2Internal &p_start, const SG
 	bounds.expand_to(p_start + p_cast_to);
 
 	broadphase->find_nearby(bounds, &result_handler, SGCollisionObject2DInternal::OBJECT_BODY);
+	find_nearby_tile_grids(bounds, &result_handler);
 	if (p_info) {
 		result_handler.populate_info(p_info);
 	}
 	return result_handler.is_intersecting();
 }
 
+class SGRayBatchCandidatesResultHandler : public SGResultHandlerInternal {
+private:
+
+	Vector<SGCollisionObject2DInternal *> &candidates;
+	uint32_t collision_mask;
+	Set<SGCollisionObject2DInternal *> *exceptions;
+
+public:
+
+	void handle_result(SGCollisionObject2DInternal *p_object) {
+		if (exceptions && exceptions->has(p_object)) {
+			return;
+		}
+		if (!(p_object->get_collision_layer() & collision_mask)) {
+			return;
+		}
+		candidates.push_back(p_object);
+	}
+
+	_FORCE_INLINE_ SGRayBatchCandidatesResultHandler(Vector<SGCollisionObject2DInternal *> &p_candidates, uint32_t p_collision_mask, Set<SGCollisionObject2DInternal *> *p_exceptions)
+		: candidates(p_candidates), collision_mask(p_collision_mask), exceptions(p_exceptions) { }
+
+};
+
+// Keeps the closest hit for a ray, the same way cast_ray() does, so the
+// candidates can be visited in a different order and still give the same
+// result.
+static _FORCE_INLINE_ void sg_handle_ray_intersection(SGWorld2DInternal::RayCastInfo &r_info, fixed &r_shortest_distance_squared, SGCollisionObject2DInternal *p_object, const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_intersection_point, const SGFixedVector2Internal &p_collision_normal) {
+	fixed distance_squared = (p_intersection_point - p_start).length_squared();
+	if (r_info.body == nullptr || distance_squared < r_shortest_distance_squared || (distance_squared == r_shortest_distance_squared && p_object->get_id() < r_info.body->get_id())) {
+		r_shortest_distance_squared = distance_squared;
+		r_info.body = (SGBody2DInternal *)p_object;
+		r_info.collision_point = p_intersection_point;
+		r_info.collision_normal = p_collision_normal;
+	}
+}
+
+void SGWorld2DInternal::cast_rays(const Vector<SGFixedVector2Internal> &p_starts, const Vector<SGFixedVector2Internal> &p_cast_tos, uint32_t p_collision_mask, Set<SGCollisionObject2DInternal *> *p_exceptions, Vector<RayCastInfo> &r_info) const {
+	ERR_FAIL_COND(p_starts.size() != p_cast_tos.size());
+
+	int ray_count = p_starts.size();
+	r_info.resize(ray_count);
+	if (ray_count == 0) {
+		return;
+	}
+
+	Vector<SGFixedRect2Internal> ray_bounds;
+	Vector<fixed> shortest_distance_squared;
+	ray_bounds.resize(ray_count);
+	shortest_distance_squared.resize(ray_count);
+
+	SGFixedRect2Internal bounds(p_starts[0], SGFixedVector2Internal());
+	for (int i = 0; i < ray_count; i++) {
+		r_info.write[i] = RayCastInfo();
+
+		SGFixedRect2Internal rb(p_starts[i], SGFixedVector2Internal());
+		rb.expand_to(p_starts[i] + p_cast_tos[i]);
+		ray_bounds.write[i] = rb;
+		bounds = bounds.merge(rb);
+	}
+
+	Vector<SGCollisionObject2DInternal *> candidates;
+	SGRayBatchCandidatesResultHandler result_handler(candidates, p_collision_mask, p_exceptions);
+	broadphase->find_nearby(bounds, &result_handler, SGCollisionObject2DInternal::OBJECT_BODY);
+	find_nearby_tile_grids(bounds, &result_handler);
+
+	SGFixedVector2Internal intersection_point;
+	SGFixedVector2Internal collision_normal;
+
+	for (int c = 0; c < candidates.size(); c++) {
+		SGCollisionObject2DInternal *object = candidates[c];
+
+		if (is_tile_grid(object)) {
+			for (int i = 0; i < ray_count; i++) {
+				if (segment_intersects_tile_grid(p_starts[i], p_cast_tos[i], (SGTileGrid2DInternal *)object, intersection_point, collision_normal)) {
+					sg_handle_ray_intersection(r_info.write[i], shortest_distance_squared.write[i], object, p_starts[i], intersection_point, collision_normal);
+				}
+			}
+			continue;
+		}
+
+		for (const List<SGShape2DInternal *>::Element *S = object->get_shapes().front(); S; S = S->next()) {
+			SGShape2DInternal *shape = S->get();
+
+			if (shape->get_shape_type() == SGShape2DInternal::SHAPE_CIRCLE) {
+				SGFixedRect2Internal shape_bounds = shape->get_bounds();
+				for (int i = 0; i < ray_count; i++) {
+					if (ray_bounds[i].intersects(shape_bounds) && SGCollisionDetector2DInternal::segment_intersects_Circle(p_starts[i], p_cast_tos[i], *(SGCircle2DInternal *)shape, intersection_point, collision_normal)) {
+						sg_handle_ray_intersection(r_info.write[i], shortest_distance_squared.write[i], object, p_starts[i], intersection_point, collision_normal);
+					}
+				}
+				continue;
+			}
+
+			// Get the transformed vertices once, and test every ray against them.
+			Vector<SGFixedVector2Internal> verts = shape->get_global_vertices();
+			if (verts.size() == 0) {
+				continue;
+			}
+			SGFixedRect2Internal shape_bounds(verts[0], SGFixedVector2Internal());
+			for (int v = 1; v < verts.size(); v++) {
+				shape_bounds.expand_to(verts[v]);
+			}
+
+			for (int i = 0; i < ray_count; i++) {
+				if (ray_bounds[i].intersects(shape_bounds) && SGCollisionDetector2DInternal::segment_intersects_Polygon(p_starts[i], p_cast_tos[i], verts, intersection_point, collision_normal)) {
+					sg_handle_ray_intersection(r_info.write[i], shortest_distance_squared.write[i], object, p_starts[i], intersection_point, collision_normal);
+				}
+			}
+		}
+	}
+}
+
+// Finds the point of p_shape that's furthest along p_direction. If a whole
+// edge is furthest, its middle is used.
+static SGFixedVector2Internal sg_get_support_point(const SGShape2DInternal *p_shape, const SGFixedVector2Internal &p_direction) {
+	if (p_shape->get_shape_type() == SGShape2DInternal::SHAPE_CIRCLE) {
+		SGFixedTransform2DInternal t = p_shape->get_global_transform();
+		// We only multiply by the scale.x because we don't support non-uniform scaling.
+		return t.get_origin() + p_direction * (((const SGCircle2DInternal *)p_shape)->get_radius() * t.get_scale().x);
+	}
+
+	Vector<SGFixedVector2Internal> vertices = p_shape->get_global_vertices();
+	SGFixedVector2Internal best_sum = vertices[0];
+	int best_count = 1;
+	fixed best_projection = vertices[0].dot(p_direction);
+	for (int i = 1; i < vertices.size(); i++) {
+		fixed projection = vertices[i].dot(p_direction);
+		if (projection > best_projection) {
+			best_sum = vertices[i];
+			best_count = 1;
+			best_projection = projection;
+		}
+		else if (projection == best_projection) {
+			best_sum += vertices[i];
+			best_count++;
+		}
+	}
+	return best_count == 1 ? best_sum : best_sum / fixed::from_int(best_count);
+}
+
+bool SGWorld2DInternal::shape_time_of_impact(SGShape2DInternal *p_shape1, SGShape2DInternal *p_shape2, const SGFixedVector2Internal &p_motion, fixed &p_time, SGFixedVector2Internal &p_collision_point, SGFixedVector2Internal &p_collision_normal) const {
+	// If they're already overlapping, we hit straight away. The separation
+	// pushes the first shape out of the second (plus half a unit), so the
+	// point of the first shape that's deepest inside the second one, pushed
+	// out by the penetration depth, lands on the surface of the second one.
+	ShapeOverlapInfo overlap_info;
+	if (overlaps(p_shape1, p_shape2, &overlap_info)) {
+		p_time = fixed::ZERO;
+		p_collision_normal = overlap_info.separation.normalized();
+		fixed depth = overlap_info.separation.length() - fixed::HALF;
+		p_collision_point = sg_get_support_point(p_shape1, -p_collision_normal) + p_collision_normal * depth;
+		return true;
+	}
+
+	SGCollisionDetector2DInternal::ImpactInfo impact_info;
+	if (!sg_sweep_shape(*p_shape1, *p_shape2, p_motion, p_time, &impact_info)) {
+		return false;
+	}
+
+	p_collision_point = impact_info.point;
+	p_collision_normal = impact_info.normal;
+	return true;
+}
+
+class SGShapeCastResultHandler : public SGResultHandlerInternal {
+private:
+
+	const SGWorld2DInternal *world;
+	SGShape2DInternal *shape;
+	const SGFixedVector2Internal &motion;
+	const SGFixedRect2Internal &bounds;
+	uint32_t collision_mask;
+	Set<SGCollisionObject2DInternal *> *exceptions;
+
+	SGCollisionObject2DInternal *collider;
+	fixed earliest_time;
+	SGFixedVector2Internal earliest_collision_point;
+	SGFixedVector2Internal earliest_collision_normal;
+	fixed time;
+	SGFixedVector2Internal collision_point;
+	SGFixedVector2Internal collision_normal;
+
+public:
+
+	void handle_result(SGCollisionObject2DInternal *p_object) {
+		if (exceptions && exceptions->has(p_object)) {
+			return;
+		}
+
+		if (!(p_object->get_collision_layer() & collision_mask)) {
+			return;
+		}
+
+		if (SGWorld2DInternal::is_tile_grid(p_object)) {
+			SGTileGrid2DInternal *tile_grid = (SGTileGrid2DInternal *)p_object;
+
+			int min_x, min_y, max_x, max_y;
+			if (!tile_grid->get_cell_range(bounds, min_x, min_y, max_x, max_y)) {
+				return;
+			}
+
+			SGRectangle2DInternal tile_shape = tile_grid->create_tile_shape();
+			for (int y = min_y; y <= max_y; y++) {
+				for (int x = min_x; x <= max_x; x++) {
+					if (!tile_grid->is_cell_solid(x, y)) {
+						continue;
+					}
+					tile_grid->set_tile_shape_cell(tile_shape, x, y);
+					if (world->shape_time_of_impact(shape, &tile_shape, motion, time, collision_point, collision_normal)) {
+						handle_impact(p_object);
+					}
+				}
+			}
+			return;
+		}
+
+		for (const List<SGShape2DInternal *>::Element *S = p_object->get_shapes().front(); S; S = S->next()) {
+			if (world->shape_time_of_impact(shape, S->get(), motion, time, collision_point, collision_normal)) {
+				handle_impact(p_object);
+			}
+		}
+	}
+
+	_FORCE_INLINE_ void handle_impact(SGCollisionObject2DInternal *p_object) {
+		if (collider == nullptr || time < earliest_time) {
+			collider = p_object;
+			earliest_time = time;
+			earliest_collision_point = collision_point;
+			earliest_collision_normal = collision_normal;
+		}
+	}
+
+	_FORCE_INLINE_ bool is_colliding() const {
+		return collider != nullptr;
+	}
+
+	_FORCE_INLINE_ void populate_info(SGWorld2DInternal::ShapeCastInfo *p_info) {
+		if (collider) {
+			p_info->collider = collider;
+			p_info->fraction = earliest_time;
+			p_info->collision_point = earliest_collision_point;
+			p_info->collision_normal = earliest_collision_normal;
+		}
+	}
+
+	_FORCE_INLINE_ SGShapeCastResultHandler(const SGWorld2DInternal *p_world, SGShape2DInternal *p_shape, const SGFixedVector2Internal &p_motion, const SGFixedRect2Internal &p_bounds, uint32_t p_collision_mask, Set<SGCollisionObject2DInternal *> *p_exceptions)
+		: world(p_world), shape(p_shape), motion(p_motion), bounds(p_bounds), collision_mask(p_collision_mask), exceptions(p_exceptions), collider(nullptr) { }
+
+};
+
+bool SGWorld2DInternal::cast_shape(SGShape2DInternal *p_shape, const SGFixedTransform2DInternal &p_transform, const SGFixedVector2Internal &p_motion, uint32_t p_collision_mask, Set<SGCollisionObject2DInternal *> *p_exceptions, SGWorld2DInternal::ShapeCastInfo *p_info) const {
+	ERR_FAIL_COND_V_MSG(p_shape->get_owner() != nullptr, false, "Can't cast a shape that belongs to a collision object.");
+	p_shape->set_transform(p_transform);
+
+	SGFixedRect2Internal bounds = p_shape->get_bounds();
+	bounds = bounds.merge(SGFixedRect2Internal(bounds.position + p_motion, bounds.size));
+
+	SGShapeCastResultHandler result_handler(this, p_shape, p_motion, bounds, p_collision_mask, p_exceptions);
+	broadphase->find_nearby(bounds, &result_handler, SGCollisionObject2DInternal::OBJECT_BODY);
+	find_nearby_tile_grids(bounds, &result_handler);
+	if (p_info) {
+		result_handler.populate_info(p_info);
+	}
+	return result_handler.is_colliding();
+}
+
 SGWorld2DInternal::SGWorld2DInternal()
 {
 	int cell_size = ProjectSettings::get_singleton()->get_setting("physics/2d/cell_size");
@@ -333,10 +1059,19 @@ SGWorld2DInternal::SGWorld2DInternal()
 	}
 
 	broadphase = memnew(SGBroadphase2DInternal(cell_size));
-	singleton = this;
+	for (int i = 0; i < SEPARATING_AXIS_CACHE_SIZE; i++) {
+		separating_axis_cache[i].object_id1 = 0;
+		separating_axis_cache[i].object_id2 = 0;
+		separating_axis_cache[i].shape_index1 = 0;
+		separating_axis_cache[i].shape_index2 = 0;
+		separating_axis_cache[i].axis = -1;
+	}
+
+	prefilter_test_count = 0;
+	prefilter_rejection_count = 0;
+	separating_axis_cache_hit_count = 0;
 }
 
 SGWorld2DInternal::~SGWorld2DInternal() {
 	memdelete(broadphase);
-	singleton = nullptr;
 }
@@ -28,20 +28,56 @@
 
 #include "sg_fixed_vector2_internal.h"
 #include "sg_fixed_rect2_internal.h"
+#include "sg_fixed_transform_2d_internal.h"
 #include "sg_result_handler_internal.h"
 
 class SGArea2DInternal;
 class SGBody2DInternal;
+class SGTileGrid2DInternal;
 class SGCollisionObject2DInternal;
 class SGShape2DInternal;
 class SGBroadphase2DInternal;
 
+// A world shares no state with any other world, so different worlds can be
+// used from different threads at the same time.
 class SGWorld2DInternal {
+	// Remembers which axis last separated a pair of shapes, so it can be
+	// tried first the next time they're tested (ex. during the binary search
+	// in move_and_collide()). This only affects the order axes are tried in,
+	// never the result, so a stale or colliding entry is harmless.
+	struct SeparatingAxisCacheEntry {
+		uint64_t object_id1;
+		uint64_t object_id2;
+		uint32_t shape_index1;
+		uint32_t shape_index2;
+		uint32_t version1;
+		uint32_t version2;
+		int axis;
+	};
+
+	enum {
+		SEPARATING_AXIS_CACHE_SIZE = 1024,
+	};
+
 	List<SGArea2DInternal *> areas;
 	List<SGBody2DInternal *> bodies;
+	List<SGTileGrid2DInternal *> tile_grids;
 	SGBroadphase2DInternal *broadphase;
 
-	static SGWorld2DInternal *singleton;
+	mutable SeparatingAxisCacheEntry separating_axis_cache[SEPARATING_AXIS_CACHE_SIZE];
+
+	mutable uint64_t prefilter_test_count;
+	mutable uint64_t prefilter_rejection_count;
+	mutable uint64_t separating_axis_cache_hit_count;
+
+	// Shapes are keyed by their owner's id and their index in it, so the
+	// cache behaves the same on every client.
+	_FORCE_INLINE_ SeparatingAxisCacheEntry &get_separating_axis_cache_entry(uint64_t p_object_id1, uint32_t p_shape_index1, uint64_t p_object_id2, uint32_t p_shape_index2) const {
+		uint64_t hash = (p_object_id1 * 0x9E3779B97F4A7C15ULL) ^ (p_object_id2 * 0xC2B2AE3D27D4EB4FULL) ^ ((((uint64_t)p_shape_index1 << 32) | p_shape_index2) * 0x165667B19E3779F9ULL);
+		return separating_axis_cache[(hash >> 32) & (SEPARATING_AXIS_CACHE_SIZE - 1)];
+	}
+
+	void clear_separating_axis_cache(const SGCollisionObject2DInternal *p_object);
 
 public:
 	struct ShapeOverlapInfo {
@@ -55,6 +91,8 @@ public:
 
 	struct BodyOverlapInfo {
 		SGCollisionObject2DInternal *collider;
+		// For tile grids, this is null, because the shape of each tile only
+		// exists during the query.
 		SGShape2DInternal *collider_shape;
 		SGShape2DInternal *local_shape;
 		SGFixedVector2Internal separation;
@@ -76,29 +114,98 @@ public:
 		}
 	};
 
-	typedef bool (*CompareCallback)(SGCollisionObject2DInternal*, SGCollisionObject2DInternal*);
+	struct ShapeCastInfo {
+		SGCollisionObject2DInternal *collider;
+		fixed fraction;
+		SGFixedVector2Internal collision_point;
+		SGFixedVector2Internal collision_normal;
 
-	static SGWorld2DInternal *get_singleton();
+		ShapeCastInfo() {
+			collider = nullptr;
+		}
+	};
+
+	struct MotionCollision {
+		SGCollisionObject2DInternal *collider;
+		SGFixedVector2Internal normal;
+		SGFixedVector2Internal remainder;
+
+		MotionCollision() {
+			collider = nullptr;
+		}
+	};
+
+	typedef bool (*CompareCallback)(SGCollisionObject2DInternal*, SGCollisionObject2DInternal*);
 
 	_FORCE_INLINE_ const List<SGBody2DInternal *> &get_bodies() const { return bodies; }
 	_FORCE_INLINE_ const List<SGArea2DInternal *> &get_areas() const { return areas; }
+	_FORCE_INLINE_ const List<SGTileGrid2DInternal *> &get_tile_grids() const { return tile_grids; }
 	_FORCE_INLINE_ const SGBroadphase2DInternal *get_broadphase() const { return broadphase; }
 
+	_FORCE_INLINE_ uint64_t get_prefilter_test_count() const { return prefilter_test_count; }
+	_FORCE_INLINE_ uint64_t get_prefilter_rejection_count() const { return prefilter_rejection_count; }
+	_FORCE_INLINE_ uint64_t get_separating_axis_cache_hit_count() const { return separating_axis_cache_hit_count; }
+	void reset_process_info();
+
 	void add_area(SGArea2DInternal *p_area);
 	void remove_area(SGArea2DInternal *p_area);
 	void add_body(SGBody2DInternal *p_body);
 	void remove_body(SGBody2DInternal *p_body);
+	void add_tile_grid(SGTileGrid2DInternal *p_tile_grid);
+	void remove_tile_grid(SGTileGrid2DInternal *p_tile_grid);
+
+	// Defers broadphase updates until end_batch_update(), so that moving many
+	// objects at once is cheaper. The world mustn't be queried in between.
+	void begin_batch_update();
+	void end_batch_update();
+
+	static bool is_tile_grid(const SGCollisionObject2DInternal *p_object);
+	// Tile grids aren't in the broadphase (they're usually huge), so this
+	// passes the ones whose bounds touch p_bounds to p_result_handler.
+	void find_nearby_tile_grids(const SGFixedRect2Internal &p_bounds, SGResultHandlerInternal *p_result_handler) const;
 
 	bool overlaps(SGCollisionObject2DInternal *p_object1, SGCollisionObject2DInternal *p_object2, BodyOverlapInfo *p_info = nullptr) const;
 	bool overlaps(SGShape2DInternal *p_shape1, SGShape2DInternal *p_shape2, ShapeOverlapInfo *p_info = nullptr) const;
+	bool overlaps_tile_grid(SGCollisionObject2DInternal *p_object, SGTileGrid2DInternal *p_tile_grid, BodyOverlapInfo *p_info = nullptr) const;
 
 	bool get_best_overlapping_body(SGCollisionObject2DInternal *p_object, BodyOverlapInfo *p_info, CompareCallback p_compare = nullptr) const;
+	bool get_best_overlapping_body(SGCollisionObject2DInternal *p_object, const Vector<SGCollisionObject2DInternal *> &p_candidates, BodyOverlapInfo *p_info, CompareCallback p_compare = nullptr) const;
+
+	// Collects the bodies and tile grids that p_object could collide with
+	// while moving by p_motion, so they can be tested over and over again
+	// without querying the broadphase.
+	void get_motion_candidates(SGCollisionObject2DInternal *p_object, const SGFixedVector2Internal &p_motion, Vector<SGCollisionObject2DInternal *> &p_candidates) const;
+
+	// Finds the fraction of p_motion at which p_object first touches one of
+	// the candidates. Returns false if it doesn't touch any.
+	bool get_time_of_impact(SGCollisionObject2DInternal *p_object, const SGFixedVector2Internal &p_motion, const Vector<SGCollisionObject2DInternal *> &p_candidates, fixed &r_time) const;
+
+	// Moves p_object by p_motion, stopping just before the first body it
+	// would hit. Returns true if it hit something, and fills in p_collision.
+	// If it starts out stuck, it's pushed out first, and the collider is the
+	// body it's stuck in, with a zero normal.
+	bool move_and_collide(SGCollisionObject2DInternal *p_object, const SGFixedVector2Internal &p_motion, MotionCollision *p_collision, CompareCallback p_compare = nullptr);
+	// Keeps moving p_object along whatever it hits, up to p_max_slides times,
+	// and returns the last motion after sliding (the same as p_motion if it
+	// didn't hit anything, or zero if it ran straight into something).
+	SGFixedVector2Internal move_and_slide(SGCollisionObject2DInternal *p_object, const SGFixedVector2Internal &p_motion, int p_max_slides, CompareCallback p_compare = nullptr);
 
 	void get_overlapping_areas(SGCollisionObject2DInternal *p_object, SGResultHandlerInternal *p_result_handler) const;
 	void get_overlapping_bodies(SGCollisionObject2DInternal *p_object, SGResultHandlerInternal *p_result_handler) const;
 
 	bool segment_intersects_shape(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, SGShape2DInternal *p_shape, SGFixedVector2Internal &p_intersection_point, SGFixedVector2Internal &p_collision_normal) const;
+	bool segment_intersects_tile_grid(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, SGTileGrid2DInternal *p_tile_grid, SGFixedVector2Internal &p_intersection_point, SGFixedVector2Internal &p_collision_normal) const;
 	bool cast_ray(const SGFixedVector2Internal &p_start, const SGFixedVector2Internal &p_cast_to, uint32_t p_collision_mask, Set<SGCollisionObject2DInternal *> *p_exceptions = nullptr, RayCastInfo *p_info = nullptr) const;
+	// Casts many rays with a single broadphase query over their combined
+	// bounds. r_info gets an entry for each ray, whose body will be null if
+	// that ray didn't hit anything.
+	void cast_rays(const Vector<SGFixedVector2Internal> &p_starts, const Vector<SGFixedVector2Internal> &p_cast_tos, uint32_t p_collision_mask, Set<SGCollisionObject2DInternal *> *p_exceptions, Vector<RayCastInfo> &r_info) const;
+
+	bool shape_time_of_impact(SGShape2DInternal *p_shape1, SGShape2DInternal *p_shape2, const SGFixedVector2Internal &p_motion, fixed &p_time, SGFixedVector2Internal &p_collision_point, SGFixedVector2Internal &p_collision_normal) const;
+	// Finds the first thing p_shape would hit if it were moved from
+	// p_transform along p_motion. The shape mustn't belong to a collision
+	// object, because its transform is replaced with p_transform.
+	bool cast_shape(SGShape2DInternal *p_shape, const SGFixedTransform2DInternal &p_transform, const SGFixedVector2Internal &p_motion, uint32_t p_collision_mask, Set<SGCollisionObject2DInternal *> *p_exceptions = nullptr, ShapeCastInfo *p_info = nullptr) const;
 
 	SGWorld2DInternal();
 	~SGWorld2DInternal();
@@ -27,6 +27,34 @@
 
 SGFixed *SGFixed::singleton = NULL;
 
+// Applies p_op to each pair of elements from the two arrays. If p_b has a
+// single element, it's used with every element of p_a.
+template <typename T>
+static PoolIntArray sg_fixed_array_op(const PoolIntArray &p_a, const PoolIntArray &p_b, T p_op) {
+	PoolIntArray ret;
+	int size = p_a.size();
+	int b_size = p_b.size();
+	ERR_FAIL_COND_V_MSG(b_size != size && b_size != 1, ret, "Arrays must be the same size, or the second array must have a single element.");
+
+	ret.resize(size);
+	PoolIntArray::Read a = p_a.read();
+	PoolIntArray::Read b = p_b.read();
+	PoolIntArray::Write w = ret.write();
+	if (b_size == 1) {
+		fixed other = fixed(b[0]);
+		for (int i = 0; i < size; i++) {
+			w[i] = p_op(fixed(a[i]), other).value;
+		}
+	}
+	else {
+		for (int i = 0; i < size; i++) {
+			w[i] = p_op(fixed(a[i]), fixed(b[i])).value;
+		}
+	}
+
+	return ret;
+}
+
 SGFixed::SGFixed() {
 	ERR_FAIL_COND(singleton != NULL);
 	singleton = this;
@@ -47,6 +75,7 @@ void SGFixed::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("to_float", "fixed_value"), &SGFixed::to_float);
 	ClassDB::bind_method(D_METHOD("mul", "fixed_one", "fixed_two"), &SGFixed::mul);
 	ClassDB::bind_method(D_METHOD("div", "fixed_one", "fixed_two"), &SGFixed::div);
+	ClassDB::bind_method(D_METHOD("muldiv", "fixed_one", "fixed_two", "fixed_three"), &SGFixed::muldiv);
 
 	ClassDB::bind_method(D_METHOD("sin", "fixed_value"), &SGFixed::sin);
 	ClassDB::bind_method(D_METHOD("cos", "fixed_value"), &SGFixed::cos);
@@ -57,6 +86,15 @@ void SGFixed::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("atan2", "fixed_y_value", "fixed_x_value"), &SGFixed::atan2);
 	ClassDB::bind_method(D_METHOD("sqrt", "fixed_value"), &SGFixed::sqrt);
 
+	ClassDB::bind_method(D_METHOD("mul_array", "fixed_values", "fixed_others"), &SGFixed::mul_array);
+	ClassDB::bind_method(D_METHOD("div_array", "fixed_values", "fixed_others"), &SGFixed::div_array);
+	ClassDB::bind_method(D_METHOD("add_array", "fixed_values", "fixed_others"), &SGFixed::add_array);
+	ClassDB::bind_method(D_METHOD("sub_array", "fixed_values", "fixed_others"), &SGFixed::sub_array);
+	ClassDB::bind_method(D_METHOD("sin_array", "fixed_values"), &SGFixed::sin_array);
+	ClassDB::bind_method(D_METHOD("cos_array", "fixed_values"), &SGFixed::cos_array);
+	ClassDB::bind_method(D_METHOD("rotate_vector2_array", "fixed_xy_values", "fixed_rotations"), &SGFixed::rotate_vector2_array);
+	ClassDB::bind_method(D_METHOD("normalize_vector2_array", "fixed_xy_values"), &SGFixed::normalize_vector2_array);
+
 	ClassDB::bind_method(D_METHOD("vector2", "fixed_x", "fixed_y"), &SGFixed::vector2);
 	ClassDB::bind_method(D_METHOD("from_float_vector2", "float_vector"), &SGFixed::from_float_vector2);
 
@@ -100,6 +138,10 @@ int64_t SGFixed::div(int64_t p_fixed_one, int64_t p_fixed_two) const {
 	return (fixed(p_fixed_one) / fixed(p_fixed_two)).value;
 }
 
+int64_t SGFixed::muldiv(int64_t p_fixed_one, int64_t p_fixed_two, int64_t p_fixed_three) const {
+	return fixed(p_fixed_one).muldiv(fixed(p_fixed_two), fixed(p_fixed_three)).value;
+}
+
 int64_t SGFixed::sin(int64_t p_fixed_value) const {
 	return fixed(p_fixed_value).sin().value;
 }
@@ -132,6 +174,97 @@ int64_t SGFixed::sqrt(int64_t p_fixed_value) const {
 	return fixed(p_fixed_value).sqrt().value;
 }
 
+PoolIntArray SGFixed::mul_array(const PoolIntArray &p_fixed_values, const PoolIntArray &p_fixed_others) const {
+	return sg_fixed_array_op(p_fixed_values, p_fixed_others, [](fixed p_a, fixed p_b) { return p_a * p_b; });
+}
+
+PoolIntArray SGFixed::div_array(const PoolIntArray &p_fixed_values, const PoolIntArray &p_fixed_others) const {
+	return sg_fixed_array_op(p_fixed_values, p_fixed_others, [](fixed p_a, fixed p_b) { return p_a / p_b; });
+}
+
+PoolIntArray SGFixed::add_array(const PoolIntArray &p_fixed_values, const PoolIntArray &p_fixed_others) const {
+	return sg_fixed_array_op(p_fixed_values, p_fixed_others, [](fixed p_a, fixed p_b) { return p_a + p_b; });
+}
+
+PoolIntArray SGFixed::sub_array(const PoolIntArray &p_fixed_values, const PoolIntArray &p_fixed_others) const {
+	return sg_fixed_array_op(p_fixed_values, p_fixed_others, [](fixed p_a, fixed p_b) { return p_a - p_b; });
+}
+
+PoolIntArray SGFixed::sin_array(const PoolIntArray &p_fixed_values) const {
+	PoolIntArray ret;
+	int size = p_fixed_values.size();
+	ret.resize(size);
+
+	PoolIntArray::Read r = p_fixed_values.read();
+	PoolIntArray::Write w = ret.write();
+	for (int i = 0; i < size; i++) {
+		w[i] = fixed(r[i]).sin().value;
+	}
+
+	return ret;
+}
+
+PoolIntArray SGFixed::cos_array(const PoolIntArray &p_fixed_values) const {
+	PoolIntArray ret;
+	int size = p_fixed_values.size();
+	ret.resize(size);
+
+	PoolIntArray::Read r = p_fixed_values.read();
+	PoolIntArray::Write w = ret.write();
+	for (int i = 0; i < size; i++) {
+		w[i] = fixed(r[i]).cos().value;
+	}
+
+	return ret;
+}
+
+PoolIntArray SGFixed::rotate_vector2_array(const PoolIntArray &p_fixed_xy_values, const PoolIntArray &p_fixed_rotations) const {
+	PoolIntArray ret;
+	int size = p_fixed_xy_values.size();
+	int rotations_size = p_fixed_rotations.size();
+	ERR_FAIL_COND_V_MSG(size % 2 != 0, ret, "Vector array must have an even number of elements (x, y, x, y, ...).");
+	ERR_FAIL_COND_V_MSG(rotations_size != size / 2 && rotations_size != 1, ret, "Rotations must have one element per vector, or a single element.");
+
+	ret.resize(size);
+	PoolIntArray::Read r = p_fixed_xy_values.read();
+	PoolIntArray::Read rotations = p_fixed_rotations.read();
+	PoolIntArray::Write w = ret.write();
+
+	fixed s, c;
+	if (rotations_size == 1) {
+		fixed(rotations[0]).sincos(s, c);
+	}
+	for (int i = 0; i < size; i += 2) {
+		if (rotations_size != 1) {
+			fixed(rotations[i / 2]).sincos(s, c);
+		}
+		fixed x = fixed(r[i]);
+		fixed y = fixed(r[i + 1]);
+		w[i] = (x * c - y * s).value;
+		w[i + 1] = (x * s + y * c).value;
+	}
+
+	return ret;
+}
+
+PoolIntArray SGFixed::normalize_vector2_array(const PoolIntArray &p_fixed_xy_values) const {
+	PoolIntArray ret;
+	int size = p_fixed_xy_values.size();
+	ERR_FAIL_COND_V_MSG(size % 2 != 0, ret, "Vector array must have an even number of elements (x, y, x, y, ...).");
+
+	ret.resize(size);
+	PoolIntArray::Read r = p_fixed_xy_values.read();
+	PoolIntArray::Write w = ret.write();
+	for (int i = 0; i < size; i += 2) {
+		SGFixedVector2Internal v(fixed(r[i]), fixed(r[i + 1]));
+		v.normalize();
+		w[i] = v.x.value;
+		w[i + 1] = v.y.value;
+	}
+
+	return ret;
+}
+
 Ref<SGFixedVector2> SGFixed::vector2(int64_t p_fixed_x, int64_t p_fixed_y) const {
 	return Ref<SGFixedVector2>(memnew(SGFixedVector2(SGFixedVector2Internal(fixed(p_fixed_x), fixed(p_fixed_y)))));
 }
@@ -62,6 +62,7 @@ public:
 
 	int64_t mul(int64_t p_fixed_one, int64_t p_fixed_two) const;
 	int64_t div(int64_t p_fixed_one, int64_t p_fixed_two) const;
+	int64_t muldiv(int64_t p_fixed_one, int64_t p_fixed_two, int64_t p_fixed_three) const;
 
 	int64_t sin(int64_t p_fixed_value) const;
 	int64_t cos(int64_t p_fixed_value) const;
@@ -72,6 +73,15 @@ public:
 	int64_t atan2(int64_t p_fixed_y_value, int64_t p_fixed_x_value) const;
 	int64_t sqrt(int64_t p_fixed_value) const;
 
+	PoolIntArray mul_array(const PoolIntArray &p_fixed_values, const PoolIntArray &p_fixed_others) const;
+	PoolIntArray div_array(const PoolIntArray &p_fixed_values, const PoolIntArray &p_fixed_others) const;
+	PoolIntArray add_array(const PoolIntArray &p_fixed_values, const PoolIntArray &p_fixed_others) const;
+	PoolIntArray sub_array(const PoolIntArray &p_fixed_values, const PoolIntArray &p_fixed_others) const;
+	PoolIntArray sin_array(const PoolIntArray &p_fixed_values) const;
+	PoolIntArray cos_array(const PoolIntArray &p_fixed_values) const;
+	PoolIntArray rotate_vector2_array(const PoolIntArray &p_fixed_xy_values, const PoolIntArray &p_fixed_rotations) const;
+	PoolIntArray normalize_vector2_array(const PoolIntArray &p_fixed_xy_values) const;
+
 	Ref<SGFixedVector2> vector2(int64_t p_fixed_x, int64_t p_fixed_y) const;
 	Ref<SGFixedVector2> from_float_vector2(const Vector2 &p_float_vector) const;
 
@@ -23,12 +23,15 @@
 
 #include "sg_fixed_vector2.h"
 
+SafeNumeric<uint64_t> SGFixedVector2::allocation_count;
+
 void SGFixedVector2::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_x"), &SGFixedVector2::get_x);
 	ClassDB::bind_method(D_METHOD("set_x", "x"), &SGFixedVector2::set_x);
 	ClassDB::bind_method(D_METHOD("get_y"), &SGFixedVector2::get_y);
 	ClassDB::bind_method(D_METHOD("set_y", "y"), &SGFixedVector2::set_y);
 
+	ClassDB::bind_method(D_METHOD("set_xy", "x", "y"), &SGFixedVector2::set_xy);
 	ClassDB::bind_method(D_METHOD("clear"), &SGFixedVector2::clear);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "x", PROPERTY_HINT_NONE), "set_x", "get_x");
@@ -42,10 +45,13 @@ void SGFixedVector2::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("imul", "value"), &SGFixedVector2::imul);
 	ClassDB::bind_method(D_METHOD("div", "value"), &SGFixedVector2::div);
 	ClassDB::bind_method(D_METHOD("idiv", "value"), &SGFixedVector2::idiv);
+	ClassDB::bind_method(D_METHOD("iadd_xy", "x", "y"), &SGFixedVector2::iadd_xy);
+	ClassDB::bind_method(D_METHOD("isub_xy", "x", "y"), &SGFixedVector2::isub_xy);
 
 	ClassDB::bind_method(D_METHOD("copy"), &SGFixedVector2::copy);
 	ClassDB::bind_method(D_METHOD("abs"), &SGFixedVector2::abs);
 	ClassDB::bind_method(D_METHOD("normalized"), &SGFixedVector2::normalized);
+	ClassDB::bind_method(D_METHOD("normalize"), &SGFixedVector2::normalize);
 	ClassDB::bind_method(D_METHOD("is_normalized"), &SGFixedVector2::is_normalized);
 	ClassDB::bind_method(D_METHOD("length"), &SGFixedVector2::length);
 	ClassDB::bind_method(D_METHOD("length_squared"), &SGFixedVector2::length_squared);
@@ -66,6 +72,7 @@ void SGFixedVector2::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("linear_interpolate", "other_vector", "weight"), &SGFixedVector2::linear_interpolate);
 
 	ClassDB::bind_method(D_METHOD("slide", "normal"), &SGFixedVector2::slide);
+	ClassDB::bind_method(D_METHOD("islide", "normal"), &SGFixedVector2::islide);
 	ClassDB::bind_method(D_METHOD("bounce", "normal"), &SGFixedVector2::bounce);
 	ClassDB::bind_method(D_METHOD("reflect", "normal"), &SGFixedVector2::reflect);
 
@@ -179,6 +186,20 @@ void SGFixedVector2::idiv(const Variant &p_other) {
 	}
 }
 
+void SGFixedVector2::iadd_xy(int64_t p_x, int64_t p_y) {
+	value += SGFixedVector2Internal(fixed(p_x), fixed(p_y));
+	if (watcher) {
+		watcher->fixed_vector2_changed(this);
+	}
+}
+
+void SGFixedVector2::isub_xy(int64_t p_x, int64_t p_y) {
+	value -= SGFixedVector2Internal(fixed(p_x), fixed(p_y));
+	if (watcher) {
+		watcher->fixed_vector2_changed(this);
+	}
+}
+
 Ref<SGFixedVector2> SGFixedVector2::copy() const {
 	return SGFixedVector2::from_internal(value);
 }
@@ -191,6 +212,13 @@ Ref<SGFixedVector2> SGFixedVector2::normalized() const {
 	return SGFixedVector2::from_internal(value.normalized());
 }
 
+void SGFixedVector2::normalize() {
+	value.normalize();
+	if (watcher) {
+		watcher->fixed_vector2_changed(this);
+	}
+}
+
 bool SGFixedVector2::is_normalized() const {
 	return value.is_normalized();
 }
@@ -266,6 +294,14 @@ Ref<SGFixedVector2> SGFixedVector2::slide(const Ref<SGFixedVector2> &p_normal) c
 	return v;
 }
 
+void SGFixedVector2::islide(const Ref<SGFixedVector2> &p_normal) {
+	ERR_FAIL_COND(!p_normal.is_valid());
+	value = value.slide(p_normal->value);
+	if (watcher) {
+		watcher->fixed_vector2_changed(this);
+	}
+}
+
 Ref<SGFixedVector2> SGFixedVector2::bounce(const Ref<SGFixedVector2> &p_normal) const {
 	ERR_FAIL_COND_V(!p_normal.is_valid(), Ref<SGFixedVector2>());
 	Ref<SGFixedVector2> v(memnew(SGFixedVector2));
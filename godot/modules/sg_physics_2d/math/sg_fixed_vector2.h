@@ -25,6 +25,7 @@
 #define SG_FIXED_VECTOR2_H
 
 #include <core/reference.h>
+#include <core/safe_refcount.h>
 #include <core/variant.h>
 
 #include "../internal/sg_fixed_vector2_internal.h"
@@ -45,6 +46,10 @@ class SGFixedVector2 : public Reference {
 	mutable SGFixedVector2Watcher *watcher;
 	SGFixedVector2Internal value;
 
+	// Vectors can be created on any thread (ex. from a script's Thread), so
+	// this has to be atomic.
+	static SafeNumeric<uint64_t> allocation_count;
+
 protected:
 	static void _bind_methods();
 
@@ -75,6 +80,14 @@ public:
 		}
 	}
 
+	void set_xy(int64_t p_x, int64_t p_y) {
+		value.x.value = p_x;
+		value.y.value = p_y;
+		if (watcher) {
+			watcher->fixed_vector2_changed(this);
+		}
+	}
+
 	_FORCE_INLINE_ void set_watcher(SGFixedVector2Watcher *p_watcher) const {
 		watcher = p_watcher;
 	}
@@ -87,11 +100,14 @@ public:
 	void imul(const Variant &p_other);
 	Variant div(const Variant &p_other) const;
 	void idiv(const Variant &p_other);
+	void iadd_xy(int64_t p_x, int64_t p_y);
+	void isub_xy(int64_t p_x, int64_t p_y);
 
 	Ref<SGFixedVector2> copy() const;
 
 	Ref<SGFixedVector2> abs() const;
 	Ref<SGFixedVector2> normalized() const;
+	void normalize();
 	bool is_normalized() const;
 
 	int64_t length() const;
@@ -113,6 +129,7 @@ public:
 	Ref<SGFixedVector2> linear_interpolate(const Ref<SGFixedVector2> &p_to, int64_t weight) const;
 
 	Ref<SGFixedVector2> slide(const Ref<SGFixedVector2> &p_normal) const;
+	void islide(const Ref<SGFixedVector2> &p_normal);
 	Ref<SGFixedVector2> bounce(const Ref<SGFixedVector2> &p_normal) const;
 	Ref<SGFixedVector2> reflect(const Ref<SGFixedVector2> &p_normal) const;
 
@@ -129,12 +146,19 @@ public:
 		return Ref<SGFixedVector2>(memnew(SGFixedVector2(p_internal)));
 	}
 
+	// Counts every SGFixedVector2 created, so scripts can see how many
+	// allocations they're causing (see SGPhysics2DServer::get_process_info()).
+	_FORCE_INLINE_ static uint64_t get_allocation_count() { return allocation_count.get(); }
+	_FORCE_INLINE_ static void reset_allocation_count() { allocation_count.set(0); }
+
 	SGFixedVector2() {
 		watcher = nullptr;
+		allocation_count.increment();
 	}
 	SGFixedVector2(const SGFixedVector2Internal& p_internal_vector) {
 		value = p_internal_vector;
 		watcher = nullptr;
+		allocation_count.increment();
 	}
 
 	~SGFixedVector2() { };
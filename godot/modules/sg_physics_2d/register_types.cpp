@@ -35,18 +35,21 @@
 #include "./scene/2d/sg_static_body_2d.h"
 #include "./scene/2d/sg_kinematic_body_2d.h"
 #include "./scene/2d/sg_ray_cast_2d.h"
+#include "./scene/2d/sg_ray_fan_2d.h"
+#include "./scene/2d/sg_tile_collision_grid_2d.h"
 #include "./scene/2d/sg_collision_shape_2d.h"
 #include "./scene/2d/sg_collision_polygon_2d.h"
 #include "./scene/2d/sg_ysort.h"
+#include "./scene/2d/sg_world_2d.h"
 #include "./scene/resources/sg_shapes_2d.h"
-#include "./internal/sg_world_2d_internal.h"
+#include "./servers/sg_physics_2d_server.h"
 
 #include "./editor/sg_fixed_math_editor_plugin.h"
 #include "./editor/sg_collision_shape_2d_editor_plugin.h"
 #include "./editor/sg_collision_polygon_2d_editor_plugin.h"
 
 static SGFixed *fixed_singleton;
-static SGWorld2DInternal *world_singleton;
+static SGPhysics2DServer *physics_2d_server;
 
 void register_sg_physics_2d_types() {
 	ClassDB::register_class<SGFixed>();
@@ -54,6 +57,8 @@ void register_sg_physics_2d_types() {
 	ClassDB::register_class<SGFixedRect2>();
 	ClassDB::register_class<SGFixedTransform2D>();
 
+	ClassDB::register_class<SGPhysics2DServer>();
+
 	ClassDB::register_class<SGFixedNode2D>();
 	ClassDB::register_class<SGFixedPosition2D>();
 	ClassDB::register_virtual_class<SGCollisionObject2D>();
@@ -62,7 +67,10 @@ void register_sg_physics_2d_types() {
 	ClassDB::register_class<SGKinematicBody2D>();
 	ClassDB::register_class<SGKinematicCollision2D>();
 	ClassDB::register_class<SGRayCast2D>();
+	ClassDB::register_class<SGRayFan2D>();
+	ClassDB::register_class<SGTileCollisionGrid2D>();
 	ClassDB::register_class<SGYSort>();
+	ClassDB::register_class<SGWorld2D>();
 
 	ClassDB::register_class<SGCollisionShape2D>();
 	ClassDB::register_class<SGCollisionPolygon2D>();
@@ -74,7 +82,8 @@ void register_sg_physics_2d_types() {
 	fixed_singleton = memnew(SGFixed);
 	Engine::get_singleton()->add_singleton(Engine::Singleton("SGFixed", SGFixed::get_singleton()));
 
-	world_singleton = memnew(SGWorld2DInternal);
+	physics_2d_server = memnew(SGPhysics2DServer);
+	Engine::get_singleton()->add_singleton(Engine::Singleton("SGPhysics2DServer", SGPhysics2DServer::get_singleton()));
 
 #ifdef TOOLS_ENABLED
 	EditorPlugins::add_by_type<SGFixedMathEditorPlugin>();
@@ -85,5 +94,5 @@ void register_sg_physics_2d_types() {
 
 void unregister_sg_physics_2d_types() {
 	memdelete(fixed_singleton);
-	memdelete(world_singleton);
+	memdelete(physics_2d_server);
 }
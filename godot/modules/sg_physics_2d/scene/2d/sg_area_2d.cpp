@@ -33,85 +33,107 @@
 void SGArea2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_overlapping_areas", "sort"), &SGArea2D::get_overlapping_areas, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("get_overlapping_bodies", "sort"), &SGArea2D::get_overlapping_bodies, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("fill_overlapping_areas", "result", "sort"), &SGArea2D::fill_overlapping_areas, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("fill_overlapping_bodies", "result", "sort"), &SGArea2D::fill_overlapping_bodies, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("get_overlapping_area_ids", "sort"), &SGArea2D::get_overlapping_area_ids, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("get_overlapping_body_ids", "sort"), &SGArea2D::get_overlapping_body_ids, DEFVAL(true));
 }
 
-struct SGCollisionObjectComparator {
-	bool operator()(const SGCollisionObject2DInternal *p_a, const SGCollisionObject2DInternal *p_b) const {
-		SGCollisionObject2D *a = Object::cast_to<SGCollisionObject2D>((Object *)p_a->get_data());
-		SGCollisionObject2D *b = Object::cast_to<SGCollisionObject2D>((Object *)p_b->get_data());
-		return b->is_greater_than(a);
-	}
-};
-
-class SGArrayResultHandler : public SGResultHandlerInternal {
+class SGBufferResultHandler : public SGResultHandlerInternal {
 private:
 
-	Array result;
+	Vector<SGCollisionObject2DInternal *> &buffer;
+	int count;
 
 public:
 	void handle_result(SGCollisionObject2DInternal *p_object) {
-		SGCollisionObject2D *object = Object::cast_to<SGCollisionObject2D>((Object *)p_object->get_data());
-		if (object) {
-			result.push_back(object);
+		if (!Object::cast_to<SGCollisionObject2D>((Object *)p_object->get_data())) {
+			return;
 		}
+		if (count == buffer.size()) {
+			buffer.resize(MAX(count * 2, 8));
+		}
+		buffer.write[count++] = p_object;
 	}
 
-	_FORCE_INLINE_ Array get_array() {
-		return result;
-	}
-
-};
+	_FORCE_INLINE_ int get_count() const { return count; }
 
-class SGSortedArrayResultHandler : public SGResultHandlerInternal {
-private:
+	_FORCE_INLINE_ SGBufferResultHandler(Vector<SGCollisionObject2DInternal *> &p_buffer)
+		: buffer(p_buffer), count(0) { }
 
-	List<SGCollisionObject2DInternal *> result;
+};
 
-public:
-	void handle_result(SGCollisionObject2DInternal *p_object) {
-		result.push_back(p_object);
+int SGArea2D::query_overlapping(bool p_areas, bool p_sort) const {
+	SGBufferResultHandler result_handler(query_buffer);
+	SGWorld2DInternal *world = get_world_internal();
+	if (p_areas) {
+		world->get_overlapping_areas((SGArea2DInternal *)internal, &result_handler);
+	}
+	else {
+		world->get_overlapping_bodies((SGArea2DInternal *)internal, &result_handler);
 	}
 
-	_FORCE_INLINE_ Array get_array() {
-		if (result.size() > 1) {
-			result.sort_custom<SGCollisionObjectComparator>();
-		}
-
-		Array ret;
-		for (List<SGCollisionObject2DInternal *>::Element *E = result.front(); E; E = E->next()) {
-			SGCollisionObject2D *object = Object::cast_to<SGCollisionObject2D>((Object *)E->get()->get_data());
-			if (object) {
-				ret.push_back(object);
-			}
+	int count = result_handler.get_count();
+	if (p_sort && count > 1) {
+		if (sort_buffer.size() < count) {
+			sort_buffer.resize(query_buffer.size());
 		}
-
-		return ret;
+		SGCollisionObject2DInternal::sort_by_id(query_buffer.ptrw(), sort_buffer.ptrw(), count);
 	}
 
-};
+	return count;
+}
 
 Array SGArea2D::get_overlapping_areas(bool sort) const {
-	if (sort) {
-		SGSortedArrayResultHandler result_handler;
-		SGWorld2DInternal::get_singleton()->get_overlapping_areas((SGArea2DInternal *)internal, &result_handler);
-		return result_handler.get_array();
+	Array result;
+	fill_overlapping_areas(result, sort);
+	return result;
+}
+
+Array SGArea2D::get_overlapping_bodies(bool sort) const {
+	Array result;
+	fill_overlapping_bodies(result, sort);
+	return result;
+}
+
+static void sg_fill_array(Array &p_result, const Vector<SGCollisionObject2DInternal *> &p_objects, int p_count) {
+	p_result.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		p_result[i] = (Object *)p_objects[i]->get_data();
 	}
+}
 
-	SGArrayResultHandler result_handler;
-	SGWorld2DInternal::get_singleton()->get_overlapping_areas((SGArea2DInternal *)internal, &result_handler);
-	return result_handler.get_array();
+int SGArea2D::fill_overlapping_areas(Array p_result, bool p_sort) const {
+	int count = query_overlapping(true, p_sort);
+	sg_fill_array(p_result, query_buffer, count);
+	return count;
 }
 
-Array SGArea2D::get_overlapping_bodies(bool sort) const {
-	if (sort) {
-		SGSortedArrayResultHandler result_handler;
-		SGWorld2DInternal::get_singleton()->get_overlapping_bodies((SGArea2DInternal *)internal, &result_handler);
-		return result_handler.get_array();
+int SGArea2D::fill_overlapping_bodies(Array p_result, bool p_sort) const {
+	int count = query_overlapping(false, p_sort);
+	sg_fill_array(p_result, query_buffer, count);
+	return count;
+}
+
+// This is a plain Array rather than a PoolIntArray, because the latter only
+// holds 32-bit integers, and instance ids need all 64 bits.
+static Array sg_get_instance_ids(const Vector<SGCollisionObject2DInternal *> &p_objects, int p_count) {
+	Array result;
+	result.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		result[i] = ((Object *)p_objects[i]->get_data())->get_instance_id();
 	}
+	return result;
+}
+
+Array SGArea2D::get_overlapping_area_ids(bool p_sort) const {
+	int count = query_overlapping(true, p_sort);
+	return sg_get_instance_ids(query_buffer, count);
+}
 
-	SGArrayResultHandler result_handler;
-	SGWorld2DInternal::get_singleton()->get_overlapping_bodies((SGArea2DInternal *)internal, &result_handler);
-	return result_handler.get_array();
+Array SGArea2D::get_overlapping_body_ids(bool p_sort) const {
+	int count = query_overlapping(false, p_sort);
+	return sg_get_instance_ids(query_buffer, count);
 }
 
 SGArea2D::SGArea2D()
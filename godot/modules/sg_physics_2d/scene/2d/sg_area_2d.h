@@ -31,6 +31,12 @@
 class SGArea2D : public SGCollisionObject2D {
 	GDCLASS(SGArea2D, SGCollisionObject2D);
 
+	// Reused between queries, so we aren't allocating on every call.
+	mutable Vector<SGCollisionObject2DInternal *> query_buffer;
+	mutable Vector<SGCollisionObject2DInternal *> sort_buffer;
+
+	int query_overlapping(bool p_areas, bool p_sort) const;
+
 protected:
 	static void _bind_methods();
 
@@ -38,6 +44,12 @@ public:
 	Array get_overlapping_areas(bool sort = true) const;
 	Array get_overlapping_bodies(bool sort = true) const;
 
+	int fill_overlapping_areas(Array p_result, bool p_sort = true) const;
+	int fill_overlapping_bodies(Array p_result, bool p_sort = true) const;
+
+	Array get_overlapping_area_ids(bool p_sort = true) const;
+	Array get_overlapping_body_ids(bool p_sort = true) const;
+
 	SGArea2D();
 	~SGArea2D();
 
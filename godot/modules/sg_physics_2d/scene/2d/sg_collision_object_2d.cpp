@@ -27,12 +27,18 @@
 
 #include "sg_collision_shape_2d.h"
 #include "sg_collision_polygon_2d.h"
+#include "sg_world_2d.h"
 #include "../../internal/sg_world_2d_internal.h"
 #include "../../internal/sg_bodies_2d_internal.h"
+#include "../../internal/sg_tile_grid_2d_internal.h"
+#include "../../servers/sg_physics_2d_server.h"
 
 void SGCollisionObject2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("sync_to_physics_engine"), &SGCollisionObject2D::sync_to_physics_engine);
 
+	ClassDB::bind_method(D_METHOD("set_object_id", "object_id"), &SGCollisionObject2D::set_object_id);
+	ClassDB::bind_method(D_METHOD("get_object_id"), &SGCollisionObject2D::get_object_id);
+
 	ClassDB::bind_method(D_METHOD("get_collision_layer"), &SGCollisionObject2D::get_collision_layer);
 	ClassDB::bind_method(D_METHOD("set_collision_layer", "collision_layer"), &SGCollisionObject2D::set_collision_layer);
 	ClassDB::bind_method(D_METHOD("get_collision_mask"), &SGCollisionObject2D::get_collision_mask);
@@ -43,6 +49,10 @@ void SGCollisionObject2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_collision_mask_bit", "bit", "value"), &SGCollisionObject2D::set_collision_mask_bit);
 	ClassDB::bind_method(D_METHOD("get_collision_mask_bit"), &SGCollisionObject2D::get_collision_mask_bit);
 
+	// Saved along with the scene (but not shown in the editor), so that state
+	// saved with PackedScene keeps the same order when it's loaded again.
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "object_id", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_object_id", "get_object_id");
+
 	ADD_GROUP("Collision", "collision_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_layer", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_collision_layer", "get_collision_layer");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_mask", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_collision_mask", "get_collision_mask");
@@ -51,7 +61,24 @@ void SGCollisionObject2D::_bind_methods() {
 void SGCollisionObject2D::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_ENTER_TREE:
-			add_to_world(SGWorld2DInternal::get_singleton());
+			// Ids are handed out the first time an object enters the tree, so
+			// they follow the order the scene was loaded in, and don't change
+			// if it's moved around in the tree later. They aren't handed out in
+			// the editor, or else they'd be saved into the scene, and every
+			// instance of it would share them.
+			if (!Engine::get_singleton()->is_editor_hint()) {
+				SGPhysics2DServer::get_singleton()->register_object_id(internal);
+			}
+			world = SGWorld2D::find_world_internal(this);
+			add_to_world(world);
+			// The broadphase element isn't created until the transform is
+			// synced, so make sure that happens if we're re-entering the tree.
+			SGPhysics2DServer::get_singleton()->add_dirty_collision_object(&sync_dirty_item);
+			break;
+
+		case NOTIFICATION_EXIT_TREE:
+			SGPhysics2DServer::get_singleton()->remove_dirty_collision_object(&sync_dirty_item);
+			SGPhysics2DServer::get_singleton()->unregister_object_id(internal);
 			break;
 		
 		case NOTIFICATION_READY:
@@ -59,15 +86,25 @@ void SGCollisionObject2D::_notification(int p_what) {
 			break;
 
 		case NOTIFICATION_EXIT_CANVAS:
-			remove_from_world(SGWorld2DInternal::get_singleton());
+			if (world) {
+				remove_from_world(world);
+				world = nullptr;
+			}
 			break;
 	}
 }
 
+SGWorld2DInternal *SGCollisionObject2D::get_world_internal() const {
+	return world ? world : SGPhysics2DServer::get_singleton()->get_default_world();
+}
+
 void SGCollisionObject2D::add_to_world(SGWorld2DInternal *p_world) const {
 	if (internal->get_object_type() == SGCollisionObject2DInternal::OBJECT_AREA) {
 		p_world->add_area((SGArea2DInternal *)internal);
 	}
+	else if (SGWorld2DInternal::is_tile_grid(internal)) {
+		p_world->add_tile_grid((SGTileGrid2DInternal *)internal);
+	}
 	else {
 		p_world->add_body((SGBody2DInternal *)internal);
 	}
@@ -77,6 +114,9 @@ void SGCollisionObject2D::remove_from_world(SGWorld2DInternal *p_world) const {
 	if (internal->get_object_type() == SGCollisionObject2DInternal::OBJECT_AREA) {
 		p_world->remove_area((SGArea2DInternal *)internal);
 	}
+	else if (SGWorld2DInternal::is_tile_grid(internal)) {
+		p_world->remove_tile_grid((SGTileGrid2DInternal *)internal);
+	}
 	else {
 		p_world->remove_body((SGBody2DInternal *)internal);
 	}
@@ -84,10 +124,43 @@ void SGCollisionObject2D::remove_from_world(SGWorld2DInternal *p_world) const {
 
 void SGCollisionObject2D::add_shape(SGShape2DInternal *p_shape) {
 	internal->add_shape(p_shape);
+	mark_shapes_dirty();
 }
 
 void SGCollisionObject2D::remove_shape(SGShape2DInternal *p_shape) {
 	internal->remove_shape(p_shape);
+	mark_shapes_dirty();
+}
+
+void SGCollisionObject2D::mark_shapes_dirty() {
+	shapes_dirty = true;
+	if (is_inside_tree()) {
+		SGPhysics2DServer::get_singleton()->add_dirty_collision_object(&sync_dirty_item);
+	}
+}
+
+void SGCollisionObject2D::_global_fixed_transform_changed() {
+	if (is_inside_tree()) {
+		SGPhysics2DServer::get_singleton()->add_dirty_collision_object(&sync_dirty_item);
+	}
+}
+
+void SGCollisionObject2D::add_shape_node(SGCollisionShape2D *p_shape_node) {
+	shape_nodes.push_back(p_shape_node);
+	mark_shapes_dirty();
+}
+
+void SGCollisionObject2D::remove_shape_node(SGCollisionShape2D *p_shape_node) {
+	shape_nodes.erase(p_shape_node);
+}
+
+void SGCollisionObject2D::add_shape_node(SGCollisionPolygon2D *p_polygon_node) {
+	polygon_nodes.push_back(p_polygon_node);
+	mark_shapes_dirty();
+}
+
+void SGCollisionObject2D::remove_shape_node(SGCollisionPolygon2D *p_polygon_node) {
+	polygon_nodes.erase(p_polygon_node);
 }
 
 String SGCollisionObject2D::get_configuration_warning() const {
@@ -123,27 +196,38 @@ void SGCollisionObject2D::sync_from_physics_engine() {
 		return;
 	}
 
-	SGFixedTransform2DInternal parent_transform = fixed_parent->get_global_fixed_transform_internal();
-	update_fixed_transform_internal(parent_transform.affine_inverse() * physics_transform);
+	update_fixed_transform_internal(fixed_parent->get_global_fixed_transform_inverse_internal() * physics_transform);
 }
 
 void SGCollisionObject2D::sync_to_physics_engine() const {
-	for (int i = 0; i < get_child_count(); i++) {
-		SGCollisionShape2D *shape = Object::cast_to<SGCollisionShape2D>(get_child(i));
-		if (shape) {
-			shape->sync_to_physics_engine();
+	// If only the body has moved, the shapes are still up-to-date, since their
+	// transforms are relative to the body.
+	if (shapes_dirty) {
+		for (int i = 0; i < shape_nodes.size(); i++) {
+			shape_nodes[i]->sync_to_physics_engine();
 		}
-		else {
-			SGCollisionPolygon2D *polygon = Object::cast_to<SGCollisionPolygon2D>(get_child(i));
-			if (polygon) {
-				polygon->sync_to_physics_engine();
-			}
+		for (int i = 0; i < polygon_nodes.size(); i++) {
+			polygon_nodes[i]->sync_to_physics_engine();
 		}
+		shapes_dirty = false;
 	}
 
 	// Update the body last, because then the shape info will be all setup to
 	// be used for updating the body's broadphase element.
 	internal->set_transform(get_global_fixed_transform_internal());
+	SGPhysics2DServer::get_singleton()->remove_dirty_collision_object(&sync_dirty_item);
+}
+
+void SGCollisionObject2D::set_object_id(int64_t p_object_id) {
+	if (is_inside_tree() && !Engine::get_singleton()->is_editor_hint()) {
+		SGPhysics2DServer::get_singleton()->change_object_id(internal, p_object_id);
+		return;
+	}
+	internal->set_id(p_object_id);
+}
+
+int64_t SGCollisionObject2D::get_object_id() const {
+	return internal->get_id();
 }
 
 uint32_t SGCollisionObject2D::get_collision_layer() const {
@@ -195,12 +279,15 @@ bool SGCollisionObject2D::get_collision_mask_bit(int p_bit) const {
 	return get_collision_mask() & (1 << p_bit);
 }
 
-SGCollisionObject2D::SGCollisionObject2D(SGCollisionObject2DInternal *p_internal) {
+SGCollisionObject2D::SGCollisionObject2D(SGCollisionObject2DInternal *p_internal) :
+		sync_dirty_item(this) {
 	internal = p_internal;
 	internal->set_data(this);
+	world = nullptr;
 
 	collision_layer = 1;
 	collision_mask = 1;
+	shapes_dirty = true;
 }
 
 SGCollisionObject2D::~SGCollisionObject2D() {
@@ -31,6 +31,8 @@
 class SGShape2DInternal;
 class SGWorld2DInternal;
 class SGCollisionObject2DInternal;
+class SGCollisionShape2D;
+class SGCollisionPolygon2D;
 
 class SGCollisionObject2D : public SGFixedNode2D {
 	GDCLASS(SGCollisionObject2D, SGFixedNode2D);
@@ -41,8 +43,15 @@ class SGCollisionObject2D : public SGFixedNode2D {
 	uint32_t collision_layer;
 	uint32_t collision_mask;
 
+	Vector<SGCollisionShape2D *> shape_nodes;
+	Vector<SGCollisionPolygon2D *> polygon_nodes;
+	mutable bool shapes_dirty;
+
 protected:
+	mutable SelfList<SGCollisionObject2D> sync_dirty_item;
+
 	SGCollisionObject2DInternal *internal;
+	SGWorld2DInternal *world;
 
 	static void _bind_methods();
 	void _notification(int p_what);
@@ -53,6 +62,15 @@ protected:
 	void add_shape(SGShape2DInternal *p_shape);
 	void remove_shape(SGShape2DInternal *p_shape);
 
+	void add_shape_node(SGCollisionShape2D *p_shape_node);
+	void remove_shape_node(SGCollisionShape2D *p_shape_node);
+	void add_shape_node(SGCollisionPolygon2D *p_polygon_node);
+	void remove_shape_node(SGCollisionPolygon2D *p_polygon_node);
+
+	void mark_shapes_dirty();
+
+	virtual void _global_fixed_transform_changed() override;
+
 	void sync_from_physics_engine();
 
 public:
@@ -61,6 +79,12 @@ public:
 	virtual void sync_to_physics_engine() const;
 
 	_FORCE_INLINE_ SGCollisionObject2DInternal *get_internal() const { return internal; }
+	// The world this object was added to, or the default world if it isn't
+	// in one.
+	SGWorld2DInternal *get_world_internal() const;
+
+	void set_object_id(int64_t p_object_id);
+	int64_t get_object_id() const;
 
 	uint32_t get_collision_layer() const;
 	void set_collision_layer(uint32_t p_collision_layer);
@@ -81,6 +81,9 @@ void SGCollisionPolygon2D::_notification(int p_what) {
 		
 		case NOTIFICATION_PARENTED:
 			collision_object = Object::cast_to<SGCollisionObject2D>(get_parent());
+			if (collision_object) {
+				collision_object->add_shape_node(this);
+			}
 			if (collision_object && !disabled && !concave) {
 				collision_object->add_shape(internal_shape);
 			}
@@ -90,6 +93,9 @@ void SGCollisionPolygon2D::_notification(int p_what) {
 			if (collision_object && !disabled && !concave) {
 				collision_object->remove_shape(internal_shape);
 			}
+			if (collision_object) {
+				collision_object->remove_shape_node(this);
+			}
 			collision_object = nullptr;
 			break;
 
@@ -390,6 +396,12 @@ void SGCollisionPolygon2D::update_internal_shape() const {
 	internal_shape->set_points(points);
 }
 
+void SGCollisionPolygon2D::_fixed_transform_changed() {
+	if (collision_object) {
+		collision_object->mark_shapes_dirty();
+	}
+}
+
 void SGCollisionPolygon2D::sync_to_physics_engine() const {
 	if (!disabled && !concave) {
 		internal_shape->set_transform(get_fixed_transform_internal());
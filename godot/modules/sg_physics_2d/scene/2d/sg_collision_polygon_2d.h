@@ -46,6 +46,8 @@ protected:
 	static void _bind_methods();
 	void _notification(int p_what);
 
+	virtual void _fixed_transform_changed() override;
+
 	void update_polygon() const;
 	void update_aabb() const;
 	void update_fixed_polygon();
@@ -67,6 +67,9 @@ void SGCollisionShape2D::_notification(int p_what) {
 		
 		case NOTIFICATION_PARENTED:
 			collision_object = Object::cast_to<SGCollisionObject2D>(get_parent());
+			if (collision_object) {
+				collision_object->add_shape_node(this);
+			}
 			if (collision_object && internal_shape && !disabled) {
 				collision_object->add_shape(internal_shape);
 			}
@@ -76,6 +79,9 @@ void SGCollisionShape2D::_notification(int p_what) {
 			if (collision_object && internal_shape && !disabled) {
 				collision_object->remove_shape(internal_shape);
 			}
+			if (collision_object) {
+				collision_object->remove_shape_node(this);
+			}
 			collision_object = nullptr;
 			break;
 
@@ -128,9 +134,18 @@ Ref<SGShape2D> SGCollisionShape2D::get_shape() {
 }
 
 void SGCollisionShape2D::_shape_changed() {
+	if (collision_object) {
+		collision_object->mark_shapes_dirty();
+	}
 	update();
 }
 
+void SGCollisionShape2D::_fixed_transform_changed() {
+	if (collision_object) {
+		collision_object->mark_shapes_dirty();
+	}
+}
+
 void SGCollisionShape2D::sync_to_physics_engine() const {
 	if (shape.is_valid() && internal_shape && !disabled) {
 		internal_shape->set_transform(get_fixed_transform_internal());
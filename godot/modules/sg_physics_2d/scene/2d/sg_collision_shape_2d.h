@@ -41,6 +41,8 @@ protected:
 	static void _bind_methods();
 	void _notification(int p_what);
 
+	virtual void _fixed_transform_changed() override;
+
 public:
 	void set_disabled(bool p_disabled);
 	bool get_disabled() const;
@@ -25,6 +25,8 @@
 
 #include <core/engine.h>
 
+#include "../../servers/sg_physics_2d_server.h"
+
 void SGFixedNode2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_fixed_transform"), &SGFixedNode2D::get_fixed_transform);
 	ClassDB::bind_method(D_METHOD("set_fixed_transform", "fixed_transform"), &SGFixedNode2D::set_fixed_transform);
@@ -77,15 +79,18 @@ void SGFixedNode2D::_bind_methods() {
 void SGFixedNode2D::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_ENTER_TREE:
-			set_process_internal(true);
+			if (fixed_xform_dirty) {
+				SGPhysics2DServer::get_singleton()->add_dirty_float_transform(&float_xform_dirty_item);
+			}
 			break;
 		
 		case NOTIFICATION_EXIT_TREE:
-			set_process_internal(false);
+			SGPhysics2DServer::get_singleton()->remove_dirty_float_transform(&float_xform_dirty_item);
 			break;
 		
-		case NOTIFICATION_INTERNAL_PROCESS:
-			update_float_transform();
+		case NOTIFICATION_PARENTED:
+		case NOTIFICATION_UNPARENTED:
+			_invalidate_global_fixed_transform();
 			break;
 	}
 }
@@ -117,22 +122,68 @@ void SGFixedNode2D::_update_fixed_transform_rotation_and_scale() {
 	new_xform.set_rotation_and_scale(fixed(fixed_rotation), fixed_scale->get_internal());
 	fixed_transform->get_x()->set_internal(new_xform[0]);
 	fixed_transform->get_y()->set_internal(new_xform[1]);
+	_mark_fixed_xform_dirty();
+}
+
+void SGFixedNode2D::_mark_fixed_xform_dirty() {
 	fixed_xform_dirty = true;
+	_invalidate_global_fixed_transform();
+	_fixed_transform_changed();
+
+	// Only nodes in the tree are drawn, so the rest will be added when they
+	// enter it.
+	if (is_inside_tree()) {
+		SGPhysics2DServer::get_singleton()->add_dirty_float_transform(&float_xform_dirty_item);
+	}
 }
 
-SGFixedTransform2DInternal SGFixedNode2D::get_global_fixed_transform_internal() const {
-	SGFixedNode2D *fixed_parent = Object::cast_to<SGFixedNode2D>(get_parent());
-	if (fixed_parent) {
-		return fixed_parent->get_global_fixed_transform_internal() * fixed_transform->get_internal();
+void SGFixedNode2D::_invalidate_global_fixed_transform() {
+	// If this node is already invalid, then so are all its children, because
+	// they can't have computed their global transform without this node
+	// computing its own first.
+	if (global_fixed_xform_dirty) {
+		return;
+	}
+
+	global_fixed_xform_dirty = true;
+	global_fixed_xform_inverse_dirty = true;
+	_global_fixed_transform_changed();
+
+	for (int i = 0; i < get_child_count(); i++) {
+		SGFixedNode2D *child = Object::cast_to<SGFixedNode2D>(get_child(i));
+		if (child) {
+			child->_invalidate_global_fixed_transform();
+		}
+	}
+}
+
+const SGFixedTransform2DInternal &SGFixedNode2D::get_global_fixed_transform_internal() const {
+	if (global_fixed_xform_dirty) {
+		SGFixedNode2D *fixed_parent = Object::cast_to<SGFixedNode2D>(get_parent());
+		if (fixed_parent) {
+			global_fixed_transform = fixed_parent->get_global_fixed_transform_internal() * fixed_transform->get_internal();
+		}
+		else {
+			global_fixed_transform = fixed_transform->get_internal();
+		}
+		global_fixed_xform_dirty = false;
 	}
-	return fixed_transform->get_internal();
+	return global_fixed_transform;
+}
+
+const SGFixedTransform2DInternal &SGFixedNode2D::get_global_fixed_transform_inverse_internal() const {
+	if (global_fixed_xform_inverse_dirty) {
+		global_fixed_transform_inverse = get_global_fixed_transform_internal().affine_inverse();
+		global_fixed_xform_inverse_dirty = false;
+	}
+	return global_fixed_transform_inverse;
 }
 
 void SGFixedNode2D::update_fixed_transform_internal(const SGFixedTransform2DInternal &p_transform) {
 	fixed_transform->set_internal(p_transform);
 	fixed_scale->set_internal(p_transform.get_scale());
 	fixed_rotation = p_transform.get_rotation().value;
-	fixed_xform_dirty = true;
+	_mark_fixed_xform_dirty();
 	_change_notify("fixed_position");
 	_change_notify("fixed_scale");
 	_change_notify("fixed_rotation");
@@ -141,7 +192,7 @@ void SGFixedNode2D::update_fixed_transform_internal(const SGFixedTransform2DInte
 void SGFixedNode2D::update_global_fixed_transform_internal(const SGFixedTransform2DInternal &p_global_transform) {
 	SGFixedNode2D *fixed_parent = Object::cast_to<SGFixedNode2D>(get_parent());
 	if (fixed_parent) {
-		update_fixed_transform_internal(fixed_parent->get_global_fixed_transform_internal().affine_inverse() * p_global_transform);
+		update_fixed_transform_internal(fixed_parent->get_global_fixed_transform_inverse_internal() * p_global_transform);
 	}
 	else {
 		update_fixed_transform_internal(p_global_transform);
@@ -195,7 +246,7 @@ void SGFixedNode2D::set_fixed_position(const Ref<SGFixedVector2> &p_fixed_positi
 	ERR_FAIL_COND(!p_fixed_position.is_valid());
 
 	fixed_transform->get_origin()->set_internal(p_fixed_position->get_internal());
-	fixed_xform_dirty = true;
+	_mark_fixed_xform_dirty();
 	_change_notify("fixed_position");
 
 #ifdef TOOLS_ENABLED
@@ -269,18 +320,18 @@ Ref<SGFixedVector2> SGFixedNode2D::get_global_fixed_position() {
 
 void SGFixedNode2D::set_fixed_position_internal(const SGFixedVector2Internal &p_fixed_position) {
 	fixed_transform->get_origin()->set_internal(p_fixed_position);
-	fixed_xform_dirty = true;
+	_mark_fixed_xform_dirty();
 }
 
 void SGFixedNode2D::set_global_fixed_position_internal(const SGFixedVector2Internal &p_fixed_position) {
 	SGFixedNode2D *fixed_parent = Object::cast_to<SGFixedNode2D>(get_parent());
 	if (fixed_parent) {
-		fixed_transform->get_origin()->set_internal(fixed_parent->get_global_fixed_transform_internal().affine_inverse().xform(p_fixed_position));
+		fixed_transform->get_origin()->set_internal(fixed_parent->get_global_fixed_transform_inverse_internal().xform(p_fixed_position));
 	}
 	else {
 		fixed_transform->get_origin()->set_internal(p_fixed_position);
 	}
-	fixed_xform_dirty = true;
+	_mark_fixed_xform_dirty();
 }
 
 
@@ -311,25 +362,35 @@ void SGFixedNode2D::update_float_transform() {
 		set_transform(float_xform);
 
 #ifdef TOOLS_ENABLED
-		updating_transform = false;;
+		updating_transform = false;
 #endif
 
 		fixed_xform_dirty = false;
+		SGPhysics2DServer::get_singleton()->remove_dirty_float_transform(&float_xform_dirty_item);
 	}
 }
 
 void SGFixedNode2D::fixed_vector2_changed(SGFixedVector2 *p_vector) {
 	if (p_vector == fixed_transform->get_origin().ptr()) {
-		fixed_xform_dirty = true;
+		_mark_fixed_xform_dirty();
 	}
 	else if (p_vector == fixed_scale.ptr()) {
 		set_fixed_scale(fixed_scale);
 	}
+	else {
+		// The x and y axes can be changed directly through the fixed_transform
+		// property.
+		_invalidate_global_fixed_transform();
+		_fixed_transform_changed();
+	}
 }
 
-SGFixedNode2D::SGFixedNode2D() {
+SGFixedNode2D::SGFixedNode2D() :
+		float_xform_dirty_item(this) {
 	fixed_transform = Ref<SGFixedTransform2D>(memnew(SGFixedTransform2D));
 	fixed_transform->get_origin()->set_watcher(this);
+	fixed_transform->get_x()->set_watcher(this);
+	fixed_transform->get_y()->set_watcher(this);
 
 	fixed_scale = Ref<SGFixedVector2>(memnew(SGFixedVector2(SGFixedVector2Internal(fixed::ONE, fixed::ONE))));
 	fixed_scale->set_watcher(this);
@@ -337,6 +398,8 @@ SGFixedNode2D::SGFixedNode2D() {
 	fixed_rotation = 0;
 
 	fixed_xform_dirty = false;
+	global_fixed_xform_dirty = true;
+	global_fixed_xform_inverse_dirty = true;
 
 #ifdef TOOLS_ENABLED
 	updating_transform = false;
@@ -349,5 +412,7 @@ SGFixedNode2D::SGFixedNode2D() {
 
 SGFixedNode2D::~SGFixedNode2D() {
 	fixed_transform->get_origin()->set_watcher(nullptr);
+	fixed_transform->get_x()->set_watcher(nullptr);
+	fixed_transform->get_y()->set_watcher(nullptr);
 	fixed_scale->set_watcher(nullptr);
 }
@@ -24,6 +24,7 @@
 #ifndef SG_FIXED_NODE_2D_H
 #define SG_FIXED_NODE_2D_H
 
+#include <core/self_list.h>
 #include <scene/2d/node_2d.h>
 
 #include "../../math/sg_fixed_vector2.h"
@@ -40,6 +41,12 @@ class SGFixedNode2D : public Node2D, public SGFixedVector2Watcher {
 	Ref<SGFixedVector2> fixed_scale;
 	int64_t fixed_rotation;
 	bool fixed_xform_dirty;
+	SelfList<SGFixedNode2D> float_xform_dirty_item;
+
+	mutable SGFixedTransform2DInternal global_fixed_transform;
+	mutable SGFixedTransform2DInternal global_fixed_transform_inverse;
+	mutable bool global_fixed_xform_dirty;
+	mutable bool global_fixed_xform_inverse_dirty;
 
 #ifdef TOOLS_ENABLED
 	bool updating_transform;
@@ -54,9 +61,15 @@ protected:
 #endif
 
 	void _update_fixed_transform_rotation_and_scale();
+	void _mark_fixed_xform_dirty();
+	void _invalidate_global_fixed_transform();
+
+	virtual void _fixed_transform_changed() {}
+	virtual void _global_fixed_transform_changed() {}
 
 	_FORCE_INLINE_ SGFixedTransform2DInternal get_fixed_transform_internal() const { return fixed_transform->get_internal(); }
-	SGFixedTransform2DInternal get_global_fixed_transform_internal() const;
+	const SGFixedTransform2DInternal &get_global_fixed_transform_internal() const;
+	const SGFixedTransform2DInternal &get_global_fixed_transform_inverse_internal() const;
 
 	void update_fixed_transform_internal(const SGFixedTransform2DInternal &p_transform);
 	void update_global_fixed_transform_internal(const SGFixedTransform2DInternal &p_global_transform);
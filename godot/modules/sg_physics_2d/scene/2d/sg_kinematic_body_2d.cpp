@@ -26,94 +26,35 @@
 #include "../../internal/sg_bodies_2d_internal.h"
 #include "../../internal/sg_world_2d_internal.h"
 
-static bool sg_compare_collision_objects(SGCollisionObject2DInternal* p_a, SGCollisionObject2DInternal *p_b) {
-	SGCollisionObject2D *a = Object::cast_to<SGCollisionObject2D>((Object *)p_a->get_data());
-	SGCollisionObject2D *b = Object::cast_to<SGCollisionObject2D>((Object *)p_b->get_data());
-	return b->is_greater_than(a);
-}
-
 void SGKinematicBody2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("move_and_collide", "linear_velocity"), &SGKinematicBody2D::_move);
-	ClassDB::bind_method(D_METHOD("move_and_slide", "linear_velocity", "max_slides"), &SGKinematicBody2D::move_and_slide, DEFVAL(4));
+	ClassDB::bind_method(D_METHOD("move_and_slide", "linear_velocity", "max_slides"), &SGKinematicBody2D::_move_and_slide, DEFVAL(4));
+	ClassDB::bind_method(D_METHOD("move_and_slide_in_place", "linear_velocity", "max_slides"), &SGKinematicBody2D::move_and_slide_in_place, DEFVAL(4));
 	ClassDB::bind_method(D_METHOD("rotate_and_slide", "rotation", "max_slides"), &SGKinematicBody2D::rotate_and_slide, DEFVAL(4));
 }
 
 bool SGKinematicBody2D::move_and_collide(const SGFixedVector2Internal &p_linear_velocity, SGKinematicBody2D::Collision &p_collision) {
-	SGWorld2DInternal *world = SGWorld2DInternal::get_singleton();
-	SGWorld2DInternal::BodyOverlapInfo overlap_info;
-
-	// First, get our body unstuck, if it's stuck.
-	bool stuck = world->get_best_overlapping_body(internal, &overlap_info, &sg_compare_collision_objects);
-	if (stuck) {
-		for (int i = 0; i < 4; i++) {
-			SGFixedTransform2DInternal t = internal->get_transform();
-			t.set_origin(t.get_origin() + overlap_info.separation);
-			internal->set_transform(t);
+	SGWorld2DInternal::MotionCollision collision;
+	bool collided = get_world_internal()->move_and_collide(internal, p_linear_velocity, &collision, &SGCollisionObject2DInternal::compare_ids);
 
-			stuck = world->get_best_overlapping_body(internal, &overlap_info, &sg_compare_collision_objects);
-			if (!stuck) {
-				break;
-			}
-		}
-	}
-	if (stuck) {
-		set_global_fixed_position_internal(internal->get_transform().get_origin());
-
-		// We can't really continue. Bail with some sort of reasonable values.
-		p_collision.collider = Object::cast_to<SGCollisionObject2D>((Object *)overlap_info.collider->get_data());
-		p_collision.normal = SGFixedVector2Internal::ZERO;
-		p_collision.remainder = p_linear_velocity;
-		return true;
+	set_global_fixed_position_internal(internal->get_transform().get_origin());
+	if (collided) {
+		// Make sure the physics engine has exactly what the node ended up
+		// with, in case converting to local coordinates rounded it.
+		sync_to_physics_engine();
 	}
 
-	// Move the body the full amount.
-	SGFixedTransform2DInternal original_transform = internal->get_transform();
-	SGFixedTransform2DInternal test_transform = original_transform;
-	SGFixedVector2Internal destination = original_transform.get_origin() + p_linear_velocity;
-	test_transform.set_origin(destination);
-	internal->set_transform(test_transform);
-
-	// Check if we're colliding. If not, sync from physics engine and bail.
-	if (!world->get_best_overlapping_body(internal, &overlap_info, &sg_compare_collision_objects)) {
-		set_global_fixed_position_internal(test_transform.get_origin());
-		return false;
+	if (collided) {
+		p_collision.collider = Object::cast_to<SGCollisionObject2D>((Object *)collision.collider->get_data());
+		p_collision.collider_rid = collision.collider->get_rid();
+		p_collision.normal = collision.normal;
+		p_collision.remainder = collision.remainder;
 	}
-	
-	// Use binary search to find the point at which we collide, and the point just before that.
-	fixed low = fixed::ZERO;
-	fixed hi = fixed::ONE;
-	for (int i = 0; i < 8; i++) {
-		fixed cur = (low + hi) * fixed::HALF;
-		SGFixedVector2Internal test_position = original_transform.get_origin() + (p_linear_velocity * cur);
-		test_transform.set_origin(test_position);
-		internal->set_transform(test_transform);
-		if (world->get_best_overlapping_body(internal, &overlap_info, &sg_compare_collision_objects)) {
-			hi = cur;
-		}
-		else {
-			low = cur;
-			set_global_fixed_position_internal(test_position);
-		}
-	}
-
-	// Whatever was last set to our fixed position will be a safe position, so
-	// let's make sure that's what ends up in the physics engine (in case the
-	// last test_transform was a hi position).
-	sync_to_physics_engine();
-
-	// At this point, the overlap_info will contain info about the collision at 'hi'
-	// which is what we want to store in p_collision.
-	p_collision.collider = Object::cast_to<SGCollisionObject2D>((Object *)overlap_info.collider->get_data());
-	p_collision.normal = overlap_info.separation.normalized();
-	p_collision.remainder = p_linear_velocity - (p_linear_velocity * low);
-
-	return true;
+	return collided;
 }
 
-Ref<SGFixedVector2> SGKinematicBody2D::move_and_slide(const Ref<SGFixedVector2> &p_linear_velocity, int p_max_slides) {
-	ERR_FAIL_COND_V(!p_linear_velocity.is_valid(), Ref<SGFixedVector2>());
-	
-	SGFixedVector2Internal motion = p_linear_velocity->get_internal();
+SGFixedVector2Internal SGKinematicBody2D::move_and_slide(const SGFixedVector2Internal &p_linear_velocity, int p_max_slides) {
+	SGFixedVector2Internal motion = p_linear_velocity;
 
 	while (p_max_slides) {
 		Collision collision;
@@ -132,24 +73,35 @@ Ref<SGFixedVector2> SGKinematicBody2D::move_and_slide(const Ref<SGFixedVector2>
 		p_max_slides--;
 	}
 
-	return Ref<SGFixedVector2>(memnew(SGFixedVector2(motion)));
+	return motion;
+}
+
+Ref<SGFixedVector2> SGKinematicBody2D::_move_and_slide(const Ref<SGFixedVector2> &p_linear_velocity, int p_max_slides) {
+	ERR_FAIL_COND_V(!p_linear_velocity.is_valid(), Ref<SGFixedVector2>());
+	return SGFixedVector2::from_internal(move_and_slide(p_linear_velocity->get_internal(), p_max_slides));
+}
+
+void SGKinematicBody2D::move_and_slide_in_place(const Ref<SGFixedVector2> &p_linear_velocity, int p_max_slides) {
+	ERR_FAIL_COND(!p_linear_velocity.is_valid());
+	SGFixedVector2Internal motion = move_and_slide(p_linear_velocity->get_internal(), p_max_slides);
+	p_linear_velocity->set_xy(motion.x.value, motion.y.value);
 }
 
 bool SGKinematicBody2D::rotate_and_slide(int64_t p_rotation, int p_max_slides) {
-	SGWorld2DInternal *world = SGWorld2DInternal::get_singleton();
+	SGWorld2DInternal *world = get_world_internal();
 	SGWorld2DInternal::BodyOverlapInfo overlap_info;
 
 	set_fixed_rotation(get_fixed_rotation() + p_rotation);
 	sync_to_physics_engine();
 
-	bool stuck = world->get_best_overlapping_body(internal, &overlap_info, &sg_compare_collision_objects);
+	bool stuck = world->get_best_overlapping_body(internal, &overlap_info, &SGCollisionObject2DInternal::compare_ids);
 	if (stuck) {
 		for (int i = 0; i < p_max_slides; i++) {
 			SGFixedTransform2DInternal t = internal->get_transform();
 			t.set_origin(t.get_origin() + overlap_info.separation);
 			internal->set_transform(t);
 
-			stuck = world->get_best_overlapping_body(internal, &overlap_info, &sg_compare_collision_objects);
+			stuck = world->get_best_overlapping_body(internal, &overlap_info, &SGCollisionObject2DInternal::compare_ids);
 			if (!stuck) {
 				break;
 			}
@@ -187,10 +139,12 @@ void SGKinematicCollision2D::set_collision(const SGKinematicBody2D::Collision &p
 
 void SGKinematicCollision2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_collider"), &SGKinematicCollision2D::get_collider);
+	ClassDB::bind_method(D_METHOD("get_collider_rid"), &SGKinematicCollision2D::get_collider_rid);
 	ClassDB::bind_method(D_METHOD("get_normal"), &SGKinematicCollision2D::get_normal);
 	ClassDB::bind_method(D_METHOD("get_remainder"), &SGKinematicCollision2D::get_remainder);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "collider"), "", "get_collider");
+	ADD_PROPERTY(PropertyInfo(Variant::_RID, "collider_rid"), "", "get_collider_rid");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "normal", PROPERTY_HINT_TYPE_STRING, "SGFixedVector2"), "", "get_normal");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "remainder", PROPERTY_HINT_TYPE_STRING, "SGFixedVector2"), "", "get_remainder");
 }
@@ -199,6 +153,10 @@ Object *SGKinematicCollision2D::get_collider() const {
 	return collision.collider;
 }
 
+RID SGKinematicCollision2D::get_collider_rid() const {
+	return collision.collider_rid;
+}
+
 Ref<SGFixedVector2> SGKinematicCollision2D::get_normal() const {
 	return normal;
 }
@@ -37,6 +37,9 @@ protected:
 public:
 	struct Collision {
 		SGCollisionObject2D *collider;
+		// Only valid for objects created through SGPhysics2DServer, which
+		// don't have a node.
+		RID collider_rid;
 		// @todo How can we get the shape in here?
 		SGFixedVector2Internal normal;
 		SGFixedVector2Internal remainder;
@@ -47,7 +50,9 @@ public:
 	};
 
 	bool move_and_collide(const SGFixedVector2Internal &p_linear_velocity, Collision &p_collision);
-	Ref<SGFixedVector2> move_and_slide(const Ref<SGFixedVector2> &p_linear_velocity, int p_max_slides);
+	SGFixedVector2Internal move_and_slide(const SGFixedVector2Internal &p_linear_velocity, int p_max_slides);
+	Ref<SGFixedVector2> _move_and_slide(const Ref<SGFixedVector2> &p_linear_velocity, int p_max_slides);
+	void move_and_slide_in_place(const Ref<SGFixedVector2> &p_linear_velocity, int p_max_slides);
 	bool rotate_and_slide(int64_t p_rotation, int p_max_slides);
 
 	Ref<SGKinematicCollision2D> _move(const Ref<SGFixedVector2> &p_linear_velocity);
@@ -73,6 +78,7 @@ protected:
 
 public:
 	Object *get_collider() const;
+	RID get_collider_rid() const;
 	Ref<SGFixedVector2> get_normal() const;
 	Ref<SGFixedVector2> get_remainder() const;
 
@@ -27,6 +27,7 @@
 #include "../../internal/sg_world_2d_internal.h"
 #include "../../internal/sg_bodies_2d_internal.h"
 #include "sg_collision_object_2d.h"
+#include "sg_world_2d.h"
 
 void SGRayCast2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_cast_to"), &SGRayCast2D::get_cast_to);
@@ -147,9 +148,10 @@ void SGRayCast2D::update_raycast_collision() {
 	SGFixedVector2Internal start = t.get_origin();
 	t.set_origin(SGFixedVector2Internal::ZERO);
 
-	if (SGWorld2DInternal::get_singleton()->cast_ray(start, t.xform(cast_to->get_internal()), collision_mask, &exceptions, &info)) {
+	if (SGWorld2D::find_world_internal(this)->cast_ray(start, t.xform(cast_to->get_internal()), collision_mask, &exceptions, &info)) {
 		colliding = true;
-		collider = ((Object *)info.body->get_data())->get_instance_id();
+		// Objects created through SGPhysics2DServer don't have a node.
+		collider = info.body->get_data() ? ((Object *)info.body->get_data())->get_instance_id() : 0;
 		collision_point->set_internal(info.collision_point);
 		collision_normal->set_internal(info.collision_normal);
 	}
@@ -216,7 +218,7 @@ void SGRayCast2D::clear_exceptions() {
 
 SGRayCast2D::SGRayCast2D() {
 	// Start casting to (0, 50) like Godot's RayCast2D.
-	cast_to = Ref<SGFixedVector2>(memnew(SGFixedVector2(SGFixedVector2Internal(fixed::ZERO, fixed(3276800)))));
+	cast_to = Ref<SGFixedVector2>(memnew(SGFixedVector2(SGFixedVector2Internal(fixed::ZERO, 50_fx))));
 	collision_mask = 1;
 
 	colliding = false;
@@ -0,0 +1,266 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "sg_ray_fan_2d.h"
+
+#include <core/engine.h>
+#include "sg_collision_object_2d.h"
+#include "sg_world_2d.h"
+
+void SGRayFan2D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_cast_to"), &SGRayFan2D::get_cast_to);
+	ClassDB::bind_method(D_METHOD("set_cast_to", "cast_to"), &SGRayFan2D::set_cast_to);
+	ClassDB::bind_method(D_METHOD("get_spread"), &SGRayFan2D::get_spread);
+	ClassDB::bind_method(D_METHOD("set_spread", "spread"), &SGRayFan2D::set_spread);
+	ClassDB::bind_method(D_METHOD("get_ray_count"), &SGRayFan2D::get_ray_count);
+	ClassDB::bind_method(D_METHOD("set_ray_count", "ray_count"), &SGRayFan2D::set_ray_count);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "cast_to", PROPERTY_HINT_TYPE_STRING, "SGFixedVector2", PROPERTY_USAGE_EDITOR), "set_cast_to", "get_cast_to");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "spread"), "set_spread", "get_spread");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "ray_count", PROPERTY_HINT_RANGE, "1,256,1"), "set_ray_count", "get_ray_count");
+
+	ClassDB::bind_method(D_METHOD("get_collision_mask"), &SGRayFan2D::get_collision_mask);
+	ClassDB::bind_method(D_METHOD("set_collision_mask", "collision_mask"), &SGRayFan2D::set_collision_mask);
+	ClassDB::bind_method(D_METHOD("set_collision_mask_bit", "bit", "value"), &SGRayFan2D::set_collision_mask_bit);
+
+	ADD_GROUP("Collision", "collision_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_mask", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_collision_mask", "get_collision_mask");
+
+	ClassDB::bind_method(D_METHOD("update_raycast_collisions"), &SGRayFan2D::update_raycast_collisions);
+	ClassDB::bind_method(D_METHOD("is_ray_colliding", "ray"), &SGRayFan2D::is_ray_colliding);
+	ClassDB::bind_method(D_METHOD("get_ray_collider", "ray"), &SGRayFan2D::get_ray_collider);
+	ClassDB::bind_method(D_METHOD("get_ray_collision_point", "ray"), &SGRayFan2D::get_ray_collision_point);
+	ClassDB::bind_method(D_METHOD("get_ray_collision_normal", "ray"), &SGRayFan2D::get_ray_collision_normal);
+
+	ClassDB::bind_method(D_METHOD("add_exception", "object"), &SGRayFan2D::add_exception);
+	ClassDB::bind_method(D_METHOD("remove_exception", "object"), &SGRayFan2D::remove_exception);
+	ClassDB::bind_method(D_METHOD("get_exceptions"), &SGRayFan2D::get_exceptions);
+	ClassDB::bind_method(D_METHOD("set_exceptions", "exceptions"), &SGRayFan2D::set_exceptions);
+	ClassDB::bind_method(D_METHOD("clear_exceptions"), &SGRayFan2D::clear_exceptions);
+
+	//
+	// For storage in TSCN and SCN files only.
+	//
+
+	ClassDB::bind_method(D_METHOD("_get_cast_to_x"), &SGRayFan2D::_get_cast_to_x);
+	ClassDB::bind_method(D_METHOD("_set_cast_to_x", "x"), &SGRayFan2D::_set_cast_to_x);
+	ClassDB::bind_method(D_METHOD("_get_cast_to_y"), &SGRayFan2D::_get_cast_to_y);
+	ClassDB::bind_method(D_METHOD("_set_cast_to_y", "y"), &SGRayFan2D::_set_cast_to_y);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "cast_to_x", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "_set_cast_to_x", "_get_cast_to_x");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "cast_to_y", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "_set_cast_to_y", "_get_cast_to_y");
+
+}
+
+void SGRayFan2D::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_DRAW: {
+			if (!Engine::get_singleton()->is_editor_hint() && !get_tree()->is_debugging_collisions_hint())
+				break;
+
+			Color draw_col = get_tree()->get_debug_collisions_color();
+			for (int i = 0; i < ray_count; i++) {
+				SGFixedVector2Internal local_cast_to = get_local_cast_to(i);
+				draw_line(Vector2(), Vector2(local_cast_to.x.to_float(), local_cast_to.y.to_float()), draw_col, 2, true);
+			}
+		} break;
+	}
+}
+
+// The rays are spread evenly from -spread/2 to spread/2 around cast_to.
+SGFixedVector2Internal SGRayFan2D::get_local_cast_to(int p_ray) const {
+	if (ray_count <= 1) {
+		return cast_to->get_internal();
+	}
+	fixed angle = fixed(-spread / 2 + (spread * p_ray) / (ray_count - 1));
+	return cast_to->get_internal().rotated(angle);
+}
+
+Ref<SGFixedVector2> SGRayFan2D::get_cast_to() const {
+	return cast_to;
+}
+
+void SGRayFan2D::set_cast_to(const Ref<SGFixedVector2> &p_cast_to) {
+	ERR_FAIL_COND(!p_cast_to.is_valid());
+	cast_to->set_internal(p_cast_to->get_internal());
+	update();
+}
+
+int64_t SGRayFan2D::_get_cast_to_x() const {
+	return cast_to->get_x();
+}
+
+void SGRayFan2D::_set_cast_to_x(int64_t p_x) {
+	cast_to->set_x(p_x);
+}
+
+int64_t SGRayFan2D::_get_cast_to_y() const {
+	return cast_to->get_y();
+}
+
+void SGRayFan2D::_set_cast_to_y(int64_t p_y) {
+	cast_to->set_y(p_y);
+}
+
+int64_t SGRayFan2D::get_spread() const {
+	return spread;
+}
+
+void SGRayFan2D::set_spread(int64_t p_spread) {
+	spread = p_spread;
+	update();
+}
+
+int SGRayFan2D::get_ray_count() const {
+	return ray_count;
+}
+
+void SGRayFan2D::set_ray_count(int p_ray_count) {
+	ERR_FAIL_COND(p_ray_count < 1);
+	ray_count = p_ray_count;
+	results.clear();
+	colliders.clear();
+	update();
+}
+
+uint32_t SGRayFan2D::get_collision_mask() const {
+	return collision_mask;
+}
+
+void SGRayFan2D::set_collision_mask(uint32_t p_collision_mask) {
+	collision_mask = p_collision_mask;
+	_change_notify("collision_mask");
+}
+
+void SGRayFan2D::set_collision_mask_bit(int p_bit, bool p_value) {
+	uint32_t m = collision_mask;
+	if (p_value) {
+		m |= (1 << p_bit);
+	}
+	else {
+		m &= ~(1 << p_bit);
+	}
+	set_collision_mask(m);
+}
+
+void SGRayFan2D::update_raycast_collisions() {
+	SGFixedTransform2DInternal t = get_global_fixed_transform_internal();
+	SGFixedVector2Internal start = t.get_origin();
+	t.set_origin(SGFixedVector2Internal::ZERO);
+
+	starts.resize(ray_count);
+	cast_tos.resize(ray_count);
+	for (int i = 0; i < ray_count; i++) {
+		starts.write[i] = start;
+		cast_tos.write[i] = t.xform(get_local_cast_to(i));
+	}
+
+	SGWorld2D::find_world_internal(this)->cast_rays(starts, cast_tos, collision_mask, &exceptions, results);
+
+	// Hold onto the instance ids, in case a collider is freed before its
+	// result is used.
+	colliders.resize(ray_count);
+	for (int i = 0; i < ray_count; i++) {
+		// Objects created through SGPhysics2DServer don't have a node.
+		SGBody2DInternal *body = results[i].body;
+		colliders.write[i] = (body && body->get_data()) ? ((Object *)body->get_data())->get_instance_id() : 0;
+	}
+}
+
+bool SGRayFan2D::is_ray_colliding(int p_ray) const {
+	ERR_FAIL_INDEX_V(p_ray, ray_count, false);
+	if (p_ray >= results.size()) {
+		return false;
+	}
+	return results[p_ray].body != nullptr;
+}
+
+Object *SGRayFan2D::get_ray_collider(int p_ray) const {
+	ERR_FAIL_INDEX_V(p_ray, ray_count, nullptr);
+	if (p_ray >= colliders.size() || !colliders[p_ray]) {
+		return nullptr;
+	}
+
+	return ObjectDB::get_instance(colliders[p_ray]);
+}
+
+Ref<SGFixedVector2> SGRayFan2D::get_ray_collision_point(int p_ray) const {
+	ERR_FAIL_INDEX_V(p_ray, ray_count, Ref<SGFixedVector2>());
+	if (!is_ray_colliding(p_ray)) {
+		return Ref<SGFixedVector2>(memnew(SGFixedVector2));
+	}
+	return SGFixedVector2::from_internal(results[p_ray].collision_point);
+}
+
+Ref<SGFixedVector2> SGRayFan2D::get_ray_collision_normal(int p_ray) const {
+	ERR_FAIL_INDEX_V(p_ray, ray_count, Ref<SGFixedVector2>());
+	if (!is_ray_colliding(p_ray)) {
+		return Ref<SGFixedVector2>(memnew(SGFixedVector2));
+	}
+	return SGFixedVector2::from_internal(results[p_ray].collision_normal);
+}
+
+void SGRayFan2D::add_exception(const Object *p_object) {
+	const SGCollisionObject2D *collision_object = Object::cast_to<SGCollisionObject2D>(p_object);
+	if (collision_object) {
+		exceptions.insert(collision_object->get_internal());
+	}
+}
+
+void SGRayFan2D::remove_exception(const Object *p_object) {
+	const SGCollisionObject2D *collision_object = Object::cast_to<SGCollisionObject2D>(p_object);
+	if (collision_object) {
+		exceptions.erase(collision_object->get_internal());
+	}
+}
+
+Array SGRayFan2D::get_exceptions() const {
+	Array result;
+	for (Set<SGCollisionObject2DInternal *>::Element *E = exceptions.front(); E; E = E->next()) {
+		result.append((SGCollisionObject2D *)E->get()->get_data());
+	}
+	return result;
+}
+
+void SGRayFan2D::set_exceptions(const Array &p_exceptions) {
+	exceptions.clear();
+	for (int i = 0; i < p_exceptions.size(); i++) {
+		add_exception(p_exceptions[i]);
+	}
+}
+
+void SGRayFan2D::clear_exceptions() {
+	exceptions.clear();
+}
+
+SGRayFan2D::SGRayFan2D() {
+	// Start casting to (0, 50) like SGRayCast2D, fanned out over 90 degrees.
+	cast_to = Ref<SGFixedVector2>(memnew(SGFixedVector2(SGFixedVector2Internal(fixed::ZERO, 50_fx))));
+	spread = fixed::PI_DIV_4.value * 2;
+	ray_count = 8;
+	collision_mask = 1;
+}
+
+SGRayFan2D::~SGRayFan2D() {
+}
@@ -0,0 +1,228 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "sg_tile_collision_grid_2d.h"
+
+#include <core/engine.h>
+
+#include "../../internal/sg_tile_grid_2d_internal.h"
+#include "../../servers/sg_physics_2d_server.h"
+
+void SGTileCollisionGrid2D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_cell_size", "cell_size"), &SGTileCollisionGrid2D::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &SGTileCollisionGrid2D::get_cell_size);
+	ClassDB::bind_method(D_METHOD("set_grid_width", "width"), &SGTileCollisionGrid2D::set_grid_width);
+	ClassDB::bind_method(D_METHOD("get_grid_width"), &SGTileCollisionGrid2D::get_grid_width);
+	ClassDB::bind_method(D_METHOD("set_grid_height", "height"), &SGTileCollisionGrid2D::set_grid_height);
+	ClassDB::bind_method(D_METHOD("get_grid_height"), &SGTileCollisionGrid2D::get_grid_height);
+
+	ClassDB::bind_method(D_METHOD("set_cell_solid", "x", "y", "solid"), &SGTileCollisionGrid2D::set_cell_solid);
+	ClassDB::bind_method(D_METHOD("is_cell_solid", "x", "y"), &SGTileCollisionGrid2D::is_cell_solid);
+	ClassDB::bind_method(D_METHOD("clear"), &SGTileCollisionGrid2D::clear);
+
+	ClassDB::bind_method(D_METHOD("world_to_map", "fixed_position"), &SGTileCollisionGrid2D::world_to_map);
+	ClassDB::bind_method(D_METHOD("map_to_world", "x", "y"), &SGTileCollisionGrid2D::map_to_world);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "cell_size", PROPERTY_HINT_TYPE_STRING, "SGFixedVector2", PROPERTY_USAGE_EDITOR), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "grid_width", PROPERTY_HINT_RANGE, "0,4096,1"), "set_grid_width", "get_grid_width");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "grid_height", PROPERTY_HINT_RANGE, "0,4096,1"), "set_grid_height", "get_grid_height");
+
+	//
+	// For storage in TSCN and SCN files only.
+	//
+
+	ClassDB::bind_method(D_METHOD("_get_cell_size_x"), &SGTileCollisionGrid2D::_get_cell_size_x);
+	ClassDB::bind_method(D_METHOD("_set_cell_size_x", "x"), &SGTileCollisionGrid2D::_set_cell_size_x);
+	ClassDB::bind_method(D_METHOD("_get_cell_size_y"), &SGTileCollisionGrid2D::_get_cell_size_y);
+	ClassDB::bind_method(D_METHOD("_set_cell_size_y", "y"), &SGTileCollisionGrid2D::_set_cell_size_y);
+	ClassDB::bind_method(D_METHOD("_get_tile_data"), &SGTileCollisionGrid2D::_get_tile_data);
+	ClassDB::bind_method(D_METHOD("_set_tile_data", "tile_data"), &SGTileCollisionGrid2D::_set_tile_data);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "cell_size_x", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "_set_cell_size_x", "_get_cell_size_x");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "cell_size_y", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "_set_cell_size_y", "_get_cell_size_y");
+	ADD_PROPERTY(PropertyInfo(Variant::POOL_INT_ARRAY, "tile_data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "_set_tile_data", "_get_tile_data");
+}
+
+void SGTileCollisionGrid2D::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_DRAW: {
+			if (!Engine::get_singleton()->is_editor_hint() && !get_tree()->is_debugging_collisions_hint()) {
+				break;
+			}
+
+			SGTileGrid2DInternal *tile_grid = get_tile_grid_internal();
+			Size2 float_cell_size = cell_size->to_float();
+			Color draw_col = get_tree()->get_debug_collisions_color();
+
+			for (int y = 0; y < tile_grid->get_height(); y++) {
+				for (int x = 0; x < tile_grid->get_width(); x++) {
+					if (tile_grid->is_cell_solid(x, y)) {
+						draw_rect(Rect2(Point2(x * float_cell_size.x, y * float_cell_size.y), float_cell_size), draw_col);
+					}
+				}
+			}
+		} break;
+	}
+}
+
+String SGTileCollisionGrid2D::get_configuration_warning() const {
+	// Skip SGCollisionObject2D's warning: tile grids don't use shape children.
+	return SGFixedNode2D::get_configuration_warning();
+}
+
+void SGTileCollisionGrid2D::sync_to_physics_engine() const {
+	internal->set_transform(get_global_fixed_transform_internal());
+	SGPhysics2DServer::get_singleton()->remove_dirty_collision_object(&sync_dirty_item);
+}
+
+void SGTileCollisionGrid2D::set_cell_size(const Ref<SGFixedVector2> &p_cell_size) {
+	ERR_FAIL_COND(!p_cell_size.is_valid());
+	cell_size->set_internal(p_cell_size->get_internal());
+	fixed_vector2_changed(cell_size.ptr());
+}
+
+Ref<SGFixedVector2> SGTileCollisionGrid2D::get_cell_size() {
+	return cell_size;
+}
+
+void SGTileCollisionGrid2D::set_grid_width(int p_width) {
+	SGTileGrid2DInternal *tile_grid = get_tile_grid_internal();
+	tile_grid->set_size(p_width, tile_grid->get_height());
+	update();
+}
+
+int SGTileCollisionGrid2D::get_grid_width() const {
+	return get_tile_grid_internal()->get_width();
+}
+
+void SGTileCollisionGrid2D::set_grid_height(int p_height) {
+	SGTileGrid2DInternal *tile_grid = get_tile_grid_internal();
+	tile_grid->set_size(tile_grid->get_width(), p_height);
+	update();
+}
+
+int SGTileCollisionGrid2D::get_grid_height() const {
+	return get_tile_grid_internal()->get_height();
+}
+
+void SGTileCollisionGrid2D::set_cell_solid(int p_x, int p_y, bool p_solid) {
+	get_tile_grid_internal()->set_cell_solid(p_x, p_y, p_solid);
+	update();
+}
+
+bool SGTileCollisionGrid2D::is_cell_solid(int p_x, int p_y) const {
+	return get_tile_grid_internal()->is_cell_solid(p_x, p_y);
+}
+
+void SGTileCollisionGrid2D::clear() {
+	get_tile_grid_internal()->clear();
+	update();
+}
+
+Vector2 SGTileCollisionGrid2D::world_to_map(const Ref<SGFixedVector2> &p_fixed_position) const {
+	ERR_FAIL_COND_V(!p_fixed_position.is_valid(), Vector2());
+
+	SGTileGrid2DInternal *tile_grid = get_tile_grid_internal();
+	SGFixedVector2Internal local = p_fixed_position->get_internal() - tile_grid->get_transform().get_origin();
+	SGFixedVector2Internal size = tile_grid->get_cell_size();
+	int64_t x = local.x.value / size.x.value;
+	int64_t y = local.y.value / size.y.value;
+	// Round towards negative infinity, rather than zero.
+	if (local.x.value < 0 && local.x.value % size.x.value != 0) {
+		x--;
+	}
+	if (local.y.value < 0 && local.y.value % size.y.value != 0) {
+		y--;
+	}
+	return Vector2(x, y);
+}
+
+Ref<SGFixedVector2> SGTileCollisionGrid2D::map_to_world(int p_x, int p_y) const {
+	SGTileGrid2DInternal *tile_grid = get_tile_grid_internal();
+	SGFixedVector2Internal size = tile_grid->get_cell_size();
+	return SGFixedVector2::from_internal(tile_grid->get_transform().get_origin() + SGFixedVector2Internal(
+		fixed(size.x.value * p_x),
+		fixed(size.y.value * p_y)));
+}
+
+int64_t SGTileCollisionGrid2D::_get_cell_size_x() const {
+	return cell_size->get_x();
+}
+
+void SGTileCollisionGrid2D::_set_cell_size_x(int64_t p_x) {
+	cell_size->set_x(p_x);
+}
+
+int64_t SGTileCollisionGrid2D::_get_cell_size_y() const {
+	return cell_size->get_y();
+}
+
+void SGTileCollisionGrid2D::_set_cell_size_y(int64_t p_y) {
+	cell_size->set_y(p_y);
+}
+
+PoolIntArray SGTileCollisionGrid2D::_get_tile_data() const {
+	const Vector<uint32_t> &cells = get_tile_grid_internal()->get_cells();
+
+	PoolIntArray tile_data;
+	tile_data.resize(cells.size());
+	PoolIntArray::Write w = tile_data.write();
+	for (int i = 0; i < cells.size(); i++) {
+		w[i] = (int)cells[i];
+	}
+	return tile_data;
+}
+
+void SGTileCollisionGrid2D::_set_tile_data(const PoolIntArray &p_tile_data) {
+	Vector<uint32_t> cells;
+	cells.resize(p_tile_data.size());
+	PoolIntArray::Read r = p_tile_data.read();
+	for (int i = 0; i < cells.size(); i++) {
+		cells.write[i] = (uint32_t)r[i];
+	}
+	get_tile_grid_internal()->set_cells(cells);
+	update();
+}
+
+void SGTileCollisionGrid2D::fixed_vector2_changed(SGFixedVector2 *p_vector) {
+	if (p_vector == cell_size.ptr()) {
+		get_tile_grid_internal()->set_cell_size(cell_size->get_internal());
+		_change_notify("cell_size");
+		update();
+	}
+	else {
+		SGFixedNode2D::fixed_vector2_changed(p_vector);
+	}
+}
+
+SGTileCollisionGrid2D::SGTileCollisionGrid2D()
+	: SGCollisionObject2D(memnew(SGTileGrid2DInternal)),
+	cell_size(Ref<SGFixedVector2>(memnew(SGFixedVector2(SGFixedVector2Internal(64_fx, 64_fx)))))
+{
+	cell_size->set_watcher(this);
+	get_tile_grid_internal()->set_cell_size(cell_size->get_internal());
+}
+
+SGTileCollisionGrid2D::~SGTileCollisionGrid2D() {
+	cell_size->set_watcher(nullptr);
+}
@@ -0,0 +1,77 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SG_TILE_COLLISION_GRID_2D_H
+#define SG_TILE_COLLISION_GRID_2D_H
+
+#include "sg_collision_object_2d.h"
+
+class SGTileGrid2DInternal;
+
+class SGTileCollisionGrid2D : public SGCollisionObject2D {
+	GDCLASS(SGTileCollisionGrid2D, SGCollisionObject2D);
+
+	Ref<SGFixedVector2> cell_size;
+
+protected:
+	static void _bind_methods();
+	void _notification(int p_what);
+
+	_FORCE_INLINE_ SGTileGrid2DInternal *get_tile_grid_internal() const { return (SGTileGrid2DInternal *)internal; }
+
+	int64_t _get_cell_size_x() const;
+	void _set_cell_size_x(int64_t p_x);
+	int64_t _get_cell_size_y() const;
+	void _set_cell_size_y(int64_t p_y);
+
+	PoolIntArray _get_tile_data() const;
+	void _set_tile_data(const PoolIntArray &p_tile_data);
+
+public:
+	virtual String get_configuration_warning() const override;
+
+	virtual void sync_to_physics_engine() const override;
+
+	void set_cell_size(const Ref<SGFixedVector2> &p_cell_size);
+	Ref<SGFixedVector2> get_cell_size();
+
+	void set_grid_width(int p_width);
+	int get_grid_width() const;
+
+	void set_grid_height(int p_height);
+	int get_grid_height() const;
+
+	void set_cell_solid(int p_x, int p_y, bool p_solid);
+	bool is_cell_solid(int p_x, int p_y) const;
+	void clear();
+
+	Vector2 world_to_map(const Ref<SGFixedVector2> &p_fixed_position) const;
+	Ref<SGFixedVector2> map_to_world(int p_x, int p_y) const;
+
+	void fixed_vector2_changed(SGFixedVector2 *p_vector);
+
+	SGTileCollisionGrid2D();
+	~SGTileCollisionGrid2D();
+};
+
+#endif
@@ -0,0 +1,116 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "sg_world_2d.h"
+
+#include <core/engine.h>
+#include <scene/main/viewport.h>
+
+#include "../../internal/sg_world_2d_internal.h"
+#include "../../servers/sg_physics_2d_server.h"
+
+// Owns the world of a viewport. It's kept in the viewport's metadata, so it
+// lives exactly as long as the viewport does, and the nodes under it have
+// always left the world by the time it's freed.
+class SGViewportWorld2D : public Reference {
+public:
+	SGWorld2DInternal *internal;
+
+	SGViewportWorld2D() {
+		internal = memnew(SGWorld2DInternal);
+		if (SGPhysics2DServer::get_singleton()) {
+			SGPhysics2DServer::get_singleton()->register_world(internal);
+		}
+	}
+
+	~SGViewportWorld2D() {
+		if (SGPhysics2DServer::get_singleton()) {
+			SGPhysics2DServer::get_singleton()->unregister_world(internal);
+		}
+		memdelete(internal);
+	}
+};
+
+// Viewports with a World2D of their own get a physics world of their own too,
+// the same as they'd get their own physics space in Godot. Viewports that
+// share the World2D of the viewport above them share its world. The root
+// viewport uses the default world.
+static bool sg_has_own_world_2d(const Viewport *p_viewport) {
+	Node *parent = p_viewport->get_parent();
+	if (!parent) {
+		return false;
+	}
+	Viewport *parent_viewport = parent->get_viewport();
+	return !parent_viewport || parent_viewport->find_world_2d() != p_viewport->find_world_2d();
+}
+
+static SGWorld2DInternal *sg_get_viewport_world_internal(Viewport *p_viewport) {
+	if (p_viewport->has_meta("_sg_world_2d")) {
+		Ref<SGViewportWorld2D> viewport_world = p_viewport->get_meta("_sg_world_2d");
+		if (viewport_world.is_valid()) {
+			return viewport_world->internal;
+		}
+	}
+
+	Ref<SGViewportWorld2D> viewport_world;
+	viewport_world.instance();
+	p_viewport->set_meta("_sg_world_2d", viewport_world);
+	return viewport_world->internal;
+}
+
+void SGWorld2D::_bind_methods() {
+}
+
+SGWorld2DInternal *SGWorld2D::find_world_internal(const Node *p_node) {
+	// In the editor, the edited scene is under one of the editor's own
+	// viewports, so leave everything in the default world.
+	bool use_viewports = !Engine::get_singleton()->is_editor_hint();
+
+	for (Node *parent = p_node->get_parent(); parent; parent = parent->get_parent()) {
+		SGWorld2D *world = Object::cast_to<SGWorld2D>(parent);
+		if (world) {
+			return world->internal;
+		}
+
+		Viewport *viewport = Object::cast_to<Viewport>(parent);
+		if (viewport && use_viewports && sg_has_own_world_2d(viewport)) {
+			return sg_get_viewport_world_internal(viewport);
+		}
+	}
+	return SGPhysics2DServer::get_singleton()->get_default_world();
+}
+
+SGWorld2D::SGWorld2D() {
+	internal = memnew(SGWorld2DInternal);
+	if (SGPhysics2DServer::get_singleton()) {
+		SGPhysics2DServer::get_singleton()->register_world(internal);
+	}
+}
+
+SGWorld2D::~SGWorld2D() {
+	if (SGPhysics2DServer::get_singleton()) {
+		SGPhysics2DServer::get_singleton()->unregister_world(internal);
+	}
+	memdelete(internal);
+}
@@ -0,0 +1,53 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef SG_WORLD_2D_H
+#define SG_WORLD_2D_H
+
+#include "sg_fixed_node_2d.h"
+
+class SGWorld2DInternal;
+
+// Gives everything under it a physics world of its own, separate from the
+// default one.
+class SGWorld2D : public SGFixedNode2D {
+	GDCLASS(SGWorld2D, SGFixedNode2D);
+
+	SGWorld2DInternal *internal;
+
+protected:
+	static void _bind_methods();
+
+public:
+	_FORCE_INLINE_ SGWorld2DInternal *get_internal() const { return internal; }
+
+	// Finds the world of the nearest SGWorld2D ancestor, or of the nearest
+	// viewport with its own World2D, or the default world if there's neither.
+	static SGWorld2DInternal *find_world_internal(const Node *p_node);
+
+	SGWorld2D();
+	~SGWorld2D();
+};
+
+#endif
@@ -73,7 +73,7 @@ void SGRectangleShape2D::fixed_vector2_changed(SGFixedVector2 *p_vector) {
 }
 
 SGShape2DInternal *SGRectangleShape2D::create_internal_shape() const {
-	return memnew(SGRectangle2DInternal(fixed(655360), fixed(655360)));
+	return memnew(SGRectangle2DInternal(10_fx, 10_fx));
 }
 
 int64_t SGRectangleShape2D::_get_extents_x() const {
@@ -104,7 +104,7 @@ void SGRectangleShape2D::draw(const RID &p_to_rid, const Color &p_color) {
 }
 
 SGRectangleShape2D::SGRectangleShape2D() : SGShape2D(),
-	extents(Ref<SGFixedVector2>(memnew(SGFixedVector2(SGFixedVector2Internal(fixed(655360), fixed(655360))))))
+	extents(Ref<SGFixedVector2>(memnew(SGFixedVector2(SGFixedVector2Internal(10_fx, 10_fx)))))
 {
 	extents->set_watcher(this);
 }
@@ -132,7 +132,7 @@ int SGCircleShape2D::get_radius() const {
 }
 
 SGShape2DInternal *SGCircleShape2D::create_internal_shape() const {
-	return memnew(SGCircle2DInternal(fixed(655360)));
+	return memnew(SGCircle2DInternal(10_fx));
 }
 
 void SGCircleShape2D::sync_to_physics_engine(SGShape2DInternal *p_internal_shape) const {
@@ -35,6 +35,7 @@ class SGShape2D : public Resource {
 	OBJ_SAVE_TYPE(SGShape2D);
 
 	friend class SGCollisionShape2D;
+	friend class SGPhysics2DServer;
 	
 protected:
 	static void _bind_methods();
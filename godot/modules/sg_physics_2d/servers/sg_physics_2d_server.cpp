@@ -0,0 +1,1053 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "sg_physics_2d_server.h"
+
+#include <core/message_queue.h>
+#include <core/os/os.h>
+
+#include "../math/sg_fixed_vector2.h"
+#include "../internal/sg_world_2d_internal.h"
+#include "../internal/sg_bodies_2d_internal.h"
+#include "../internal/sg_shapes_2d_internal.h"
+#include "../internal/sg_rectangle_merger_2d_internal.h"
+#include "../scene/2d/sg_fixed_node_2d.h"
+#include "../scene/2d/sg_collision_object_2d.h"
+#include "../scene/2d/sg_static_body_2d.h"
+#include "../scene/2d/sg_kinematic_body_2d.h"
+#include "../scene/2d/sg_collision_shape_2d.h"
+#include "../scene/2d/sg_world_2d.h"
+#include "../scene/resources/sg_shapes_2d.h"
+
+SGPhysics2DServer *SGPhysics2DServer::singleton = NULL;
+
+SGPhysics2DServer::SGPhysics2DServer() {
+	ERR_FAIL_COND(singleton != NULL);
+	singleton = this;
+	float_transform_sync_count = 0;
+	world_step_thread_count = -1;
+	collision_object_sync_count = 0;
+	next_object_id = 1;
+	default_world = memnew(SGWorld2DInternal);
+}
+
+SGPhysics2DServer::~SGPhysics2DServer() {
+	List<RID> owned;
+	collision_object_owner.get_owned_list(&owned);
+	if (owned.size()) {
+		WARN_PRINT(itos(owned.size()) + " RIDs of collision objects were leaked in SGPhysics2DServer.");
+		for (List<RID>::Element *E = owned.front(); E; E = E->next()) {
+			free_rid(E->get());
+		}
+	}
+
+	owned.clear();
+	world_owner.get_owned_list(&owned);
+	if (owned.size()) {
+		WARN_PRINT(itos(owned.size()) + " RIDs of worlds were leaked in SGPhysics2DServer.");
+		for (List<RID>::Element *E = owned.front(); E; E = E->next()) {
+			free_rid(E->get());
+		}
+	}
+
+	world_step_pool.finish();
+	memdelete(default_world);
+	singleton = NULL;
+}
+
+SGPhysics2DServer *SGPhysics2DServer::get_singleton() {
+	return singleton;
+}
+
+void SGPhysics2DServer::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_process_info", "process_info"), &SGPhysics2DServer::get_process_info);
+	ClassDB::bind_method(D_METHOD("reset_process_info"), &SGPhysics2DServer::reset_process_info);
+	ClassDB::bind_method(D_METHOD("set_next_object_id", "next_object_id"), &SGPhysics2DServer::set_next_object_id);
+	ClassDB::bind_method(D_METHOD("get_next_object_id"), &SGPhysics2DServer::get_next_object_id);
+	ClassDB::bind_method(D_METHOD("world_create"), &SGPhysics2DServer::world_create);
+	ClassDB::bind_method(D_METHOD("world_queue_positions", "world", "objects", "positions"), &SGPhysics2DServer::world_queue_positions);
+	ClassDB::bind_method(D_METHOD("world_queue_motions", "world", "bodies", "motions", "max_slides"), &SGPhysics2DServer::world_queue_motions, DEFVAL(4));
+	ClassDB::bind_method(D_METHOD("world_get_motion_results", "world"), &SGPhysics2DServer::world_get_motion_results);
+	ClassDB::bind_method(D_METHOD("world_set_monitored_areas", "world", "areas"), &SGPhysics2DServer::world_set_monitored_areas);
+	ClassDB::bind_method(D_METHOD("world_get_area_overlaps", "world"), &SGPhysics2DServer::world_get_area_overlaps);
+	ClassDB::bind_method(D_METHOD("world_set_ray_casts", "world", "starts", "cast_tos", "collision_mask"), &SGPhysics2DServer::world_set_ray_casts, DEFVAL(1));
+	ClassDB::bind_method(D_METHOD("world_get_ray_results", "world"), &SGPhysics2DServer::world_get_ray_results);
+	ClassDB::bind_method(D_METHOD("worlds_step", "worlds"), &SGPhysics2DServer::worlds_step);
+	ClassDB::bind_method(D_METHOD("worlds_set_thread_count", "thread_count"), &SGPhysics2DServer::worlds_set_thread_count);
+	ClassDB::bind_method(D_METHOD("worlds_get_thread_count"), &SGPhysics2DServer::worlds_get_thread_count);
+	ClassDB::bind_method(D_METHOD("area_create", "world"), &SGPhysics2DServer::area_create, DEFVAL(RID()));
+	ClassDB::bind_method(D_METHOD("body_create", "body_type", "world"), &SGPhysics2DServer::body_create, DEFVAL(BODY_KINEMATIC), DEFVAL(RID()));
+	ClassDB::bind_method(D_METHOD("free_rid", "rid"), &SGPhysics2DServer::free_rid);
+	ClassDB::bind_method(D_METHOD("collision_object_add_rectangle_shape", "object", "extents_x", "extents_y", "offset_x", "offset_y"), &SGPhysics2DServer::collision_object_add_rectangle_shape, DEFVAL(0), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("collision_object_add_circle_shape", "object", "radius", "offset_x", "offset_y"), &SGPhysics2DServer::collision_object_add_circle_shape, DEFVAL(0), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("collision_object_clear_shapes", "object"), &SGPhysics2DServer::collision_object_clear_shapes);
+	ClassDB::bind_method(D_METHOD("collision_object_set_position", "object", "x", "y"), &SGPhysics2DServer::collision_object_set_position);
+	ClassDB::bind_method(D_METHOD("collision_object_set_rotation", "object", "rotation"), &SGPhysics2DServer::collision_object_set_rotation);
+	ClassDB::bind_method(D_METHOD("collision_objects_set_positions", "objects", "positions"), &SGPhysics2DServer::collision_objects_set_positions);
+	ClassDB::bind_method(D_METHOD("collision_object_set_collision_layer", "object", "collision_layer"), &SGPhysics2DServer::collision_object_set_collision_layer);
+	ClassDB::bind_method(D_METHOD("collision_object_set_collision_mask", "object", "collision_mask"), &SGPhysics2DServer::collision_object_set_collision_mask);
+	ClassDB::bind_method(D_METHOD("area_get_overlapping_areas", "area", "sort"), &SGPhysics2DServer::area_get_overlapping_areas, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("area_get_overlapping_bodies", "area", "sort"), &SGPhysics2DServer::area_get_overlapping_bodies, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("merge_static_bodies", "bodies"), &SGPhysics2DServer::merge_static_bodies);
+	ClassDB::bind_method(D_METHOD("move_and_slide_bodies", "bodies", "velocities", "max_slides"), &SGPhysics2DServer::move_and_slide_bodies, DEFVAL(4));
+	ClassDB::bind_method(D_METHOD("cast_shape", "shape", "transform", "motion", "collision_mask", "exceptions", "world"), &SGPhysics2DServer::cast_shape, DEFVAL(1), DEFVAL(Array()), DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("flush_float_transforms"), &SGPhysics2DServer::flush_float_transforms);
+	ClassDB::bind_method(D_METHOD("sync_all_dirty"), &SGPhysics2DServer::sync_all_dirty);
+
+	BIND_ENUM_CONSTANT(INFO_PREFILTER_TESTS);
+	BIND_ENUM_CONSTANT(INFO_PREFILTER_REJECTIONS);
+	BIND_ENUM_CONSTANT(INFO_SEPARATING_AXIS_CACHE_HITS);
+	BIND_ENUM_CONSTANT(INFO_FIXED_VECTOR2_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(INFO_FLOAT_TRANSFORM_SYNCS);
+	BIND_ENUM_CONSTANT(INFO_COLLISION_OBJECT_SYNCS);
+
+	BIND_ENUM_CONSTANT(BODY_STATIC);
+	BIND_ENUM_CONSTANT(BODY_KINEMATIC);
+}
+
+int64_t SGPhysics2DServer::get_process_info(ProcessInfo p_info) const {
+	uint64_t total = 0;
+	switch (p_info) {
+		case INFO_PREFILTER_TESTS:
+			total = default_world->get_prefilter_test_count();
+			for (Set<SGWorld2DInternal *>::Element *E = worlds.front(); E; E = E->next()) {
+				total += E->get()->get_prefilter_test_count();
+			}
+			return total;
+		case INFO_PREFILTER_REJECTIONS:
+			total = default_world->get_prefilter_rejection_count();
+			for (Set<SGWorld2DInternal *>::Element *E = worlds.front(); E; E = E->next()) {
+				total += E->get()->get_prefilter_rejection_count();
+			}
+			return total;
+		case INFO_SEPARATING_AXIS_CACHE_HITS:
+			total = default_world->get_separating_axis_cache_hit_count();
+			for (Set<SGWorld2DInternal *>::Element *E = worlds.front(); E; E = E->next()) {
+				total += E->get()->get_separating_axis_cache_hit_count();
+			}
+			return total;
+		case INFO_FIXED_VECTOR2_ALLOCATIONS:
+			return SGFixedVector2::get_allocation_count();
+		case INFO_FLOAT_TRANSFORM_SYNCS:
+			return float_transform_sync_count;
+		case INFO_COLLISION_OBJECT_SYNCS:
+			return collision_object_sync_count;
+	}
+	return 0;
+}
+
+void SGPhysics2DServer::reset_process_info() {
+	default_world->reset_process_info();
+	for (Set<SGWorld2DInternal *>::Element *E = worlds.front(); E; E = E->next()) {
+		E->get()->reset_process_info();
+	}
+	SGFixedVector2::reset_allocation_count();
+	float_transform_sync_count = 0;
+	collision_object_sync_count = 0;
+}
+
+void SGPhysics2DServer::add_dirty_float_transform(SelfList<SGFixedNode2D> *p_item) {
+	if (p_item->in_list()) {
+		return;
+	}
+
+	// Schedule a single flush for when the first node becomes dirty, rather
+	// than having every node check itself each frame.
+	if (dirty_float_transforms.first() == nullptr) {
+		MessageQueue::get_singleton()->push_call(this, "flush_float_transforms");
+	}
+	dirty_float_transforms.add(p_item);
+}
+
+void SGPhysics2DServer::remove_dirty_float_transform(SelfList<SGFixedNode2D> *p_item) {
+	if (p_item->in_list()) {
+		dirty_float_transforms.remove(p_item);
+	}
+}
+
+void SGPhysics2DServer::flush_float_transforms() {
+	while (dirty_float_transforms.first()) {
+		SelfList<SGFixedNode2D> *item = dirty_float_transforms.first();
+		dirty_float_transforms.remove(item);
+		item->self()->update_float_transform();
+		float_transform_sync_count++;
+	}
+}
+
+void SGPhysics2DServer::add_dirty_collision_object(SelfList<SGCollisionObject2D> *p_item) {
+	if (!p_item->in_list()) {
+		dirty_collision_objects.add_last(p_item);
+	}
+}
+
+void SGPhysics2DServer::remove_dirty_collision_object(SelfList<SGCollisionObject2D> *p_item) {
+	if (p_item->in_list()) {
+		dirty_collision_objects.remove(p_item);
+	}
+}
+
+void SGPhysics2DServer::register_world(SGWorld2DInternal *p_world) {
+	worlds.insert(p_world);
+}
+
+void SGPhysics2DServer::unregister_world(SGWorld2DInternal *p_world) {
+	worlds.erase(p_world);
+}
+
+int64_t SGPhysics2DServer::allocate_object_id() {
+	// The counter may have been set back below ids that are still in use.
+	while (live_object_ids.has(next_object_id)) {
+		next_object_id++;
+	}
+	return next_object_id++;
+}
+
+void SGPhysics2DServer::register_object_id(SGCollisionObject2DInternal *p_object) {
+	int64_t id = p_object->get_id();
+	SGCollisionObject2DInternal **owner = live_object_ids.getptr(id);
+	if (id == 0 || (owner && *owner != p_object)) {
+		// Copies made with Node.duplicate(), or several instances of a saved
+		// scene, would otherwise share the same id.
+		id = allocate_object_id();
+		p_object->set_id(id);
+	}
+	else if (id >= next_object_id) {
+		next_object_id = id + 1;
+	}
+	live_object_ids.set(id, p_object);
+}
+
+void SGPhysics2DServer::unregister_object_id(SGCollisionObject2DInternal *p_object) {
+	SGCollisionObject2DInternal **owner = live_object_ids.getptr(p_object->get_id());
+	if (owner && *owner == p_object) {
+		live_object_ids.erase(p_object->get_id());
+	}
+}
+
+void SGPhysics2DServer::change_object_id(SGCollisionObject2DInternal *p_object, int64_t p_object_id) {
+	unregister_object_id(p_object);
+	if (p_object_id == 0) {
+		p_object_id = allocate_object_id();
+	}
+	else if (p_object_id >= next_object_id) {
+		next_object_id = p_object_id + 1;
+	}
+	p_object->set_id(p_object_id);
+	live_object_ids.set(p_object_id, p_object);
+}
+
+void SGPhysics2DServer::set_next_object_id(int64_t p_next_object_id) {
+	next_object_id = p_next_object_id;
+}
+
+int64_t SGPhysics2DServer::get_next_object_id() const {
+	return next_object_id;
+}
+
+RID SGPhysics2DServer::collision_object_create(SGCollisionObject2DInternal *p_internal, RID p_world) {
+	WorldData *world_data = p_world.is_valid() ? world_owner.getornull(p_world) : nullptr;
+
+	CollisionObjectData *object = memnew(CollisionObjectData);
+	object->internal = p_internal;
+	object->world = world_data;
+	if (world_data) {
+		world_data->object_count++;
+	}
+
+	RID rid = collision_object_owner.make_rid(object);
+	p_internal->set_rid(rid);
+	register_object_id(p_internal);
+
+	// Like nodes, it's added to the broadphase when its transform is first set.
+	SGWorld2DInternal *world = get_object_world(object);
+	if (p_internal->get_object_type() == SGCollisionObject2DInternal::OBJECT_AREA) {
+		world->add_area((SGArea2DInternal *)p_internal);
+	}
+	else {
+		world->add_body((SGBody2DInternal *)p_internal);
+	}
+	p_internal->set_transform(SGFixedTransform2DInternal());
+
+	return rid;
+}
+
+RID SGPhysics2DServer::area_create(RID p_world) {
+	ERR_FAIL_COND_V_MSG(p_world.is_valid() && !world_owner.owns(p_world), RID(), "Invalid world RID.");
+	return collision_object_create(memnew(SGArea2DInternal), p_world);
+}
+
+RID SGPhysics2DServer::body_create(BodyType p_body_type, RID p_world) {
+	ERR_FAIL_COND_V_MSG(p_world.is_valid() && !world_owner.owns(p_world), RID(), "Invalid world RID.");
+	SGBody2DInternal::BodyType body_type = (p_body_type == BODY_STATIC) ? SGBody2DInternal::BODY_STATIC : SGBody2DInternal::BODY_KINEMATIC;
+	return collision_object_create(memnew(SGBody2DInternal(body_type)), p_world);
+}
+
+void SGPhysics2DServer::free_rid(RID p_rid) {
+	WorldData *world_data = world_owner.getornull(p_rid);
+	if (world_data) {
+		ERR_FAIL_COND_MSG(world_data->object_count > 0, "Can't free a world that still has collision objects in it.");
+		unregister_world(world_data->internal);
+		memdelete(world_data->internal);
+		world_owner.free(p_rid);
+		memdelete(world_data);
+		return;
+	}
+
+	CollisionObjectData *object = collision_object_owner.getornull(p_rid);
+	ERR_FAIL_COND_MSG(!object, "Invalid RID.");
+
+	SGCollisionObject2DInternal *internal = object->internal;
+	SGWorld2DInternal *world = get_object_world(object);
+	if (internal->get_object_type() == SGCollisionObject2DInternal::OBJECT_AREA) {
+		world->remove_area((SGArea2DInternal *)internal);
+	}
+	else {
+		world->remove_body((SGBody2DInternal *)internal);
+	}
+
+	if (object->world) {
+		// Drop any work still waiting for it.
+		WorldData *owner = object->world;
+		for (int i = owner->queued_objects.size() - 1; i >= 0; i--) {
+			if (owner->queued_objects[i] == internal) {
+				owner->queued_objects.remove(i);
+				owner->queued_positions.remove(i);
+			}
+		}
+		for (int i = owner->queued_motion_bodies.size() - 1; i >= 0; i--) {
+			if (owner->queued_motion_bodies[i] == internal) {
+				owner->queued_motion_bodies.remove(i);
+				owner->queued_motions.remove(i);
+				owner->queued_max_slides.remove(i);
+			}
+		}
+		owner->monitored_areas.erase(internal);
+		for (int i = 0; i < owner->ray_result_colliders.size(); i++) {
+			if (owner->ray_result_colliders[i] == p_rid) {
+				owner->ray_result_colliders.write[i] = RID();
+			}
+		}
+		owner->object_count--;
+	}
+
+	collision_object_clear_shapes(p_rid);
+	unregister_object_id(internal);
+	memdelete(internal);
+
+	collision_object_owner.free(p_rid);
+	memdelete(object);
+}
+
+void SGPhysics2DServer::collision_object_add_rectangle_shape(RID p_object, int64_t p_extents_x, int64_t p_extents_y, int64_t p_offset_x, int64_t p_offset_y) {
+	CollisionObjectData *object = collision_object_owner.getornull(p_object);
+	ERR_FAIL_COND(!object);
+
+	SGRectangle2DInternal *shape = memnew(SGRectangle2DInternal(fixed(p_extents_x), fixed(p_extents_y)));
+	SGFixedTransform2DInternal t;
+	t.set_origin(SGFixedVector2Internal(fixed(p_offset_x), fixed(p_offset_y)));
+	shape->set_transform(t);
+	object->internal->add_shape(shape);
+}
+
+void SGPhysics2DServer::collision_object_add_circle_shape(RID p_object, int64_t p_radius, int64_t p_offset_x, int64_t p_offset_y) {
+	CollisionObjectData *object = collision_object_owner.getornull(p_object);
+	ERR_FAIL_COND(!object);
+
+	SGCircle2DInternal *shape = memnew(SGCircle2DInternal(fixed(p_radius)));
+	SGFixedTransform2DInternal t;
+	t.set_origin(SGFixedVector2Internal(fixed(p_offset_x), fixed(p_offset_y)));
+	shape->set_transform(t);
+	object->internal->add_shape(shape);
+}
+
+void SGPhysics2DServer::collision_object_clear_shapes(RID p_object) {
+	CollisionObjectData *object = collision_object_owner.getornull(p_object);
+	ERR_FAIL_COND(!object);
+
+	while (object->internal->get_shapes().size() > 0) {
+		SGShape2DInternal *shape = object->internal->get_shapes().front()->get();
+		object->internal->remove_shape(shape);
+		memdelete(shape);
+	}
+}
+
+void SGPhysics2DServer::collision_object_set_position(RID p_object, int64_t p_x, int64_t p_y) {
+	CollisionObjectData *object = collision_object_owner.getornull(p_object);
+	ERR_FAIL_COND(!object);
+
+	SGFixedTransform2DInternal t = object->internal->get_transform();
+	t.set_origin(SGFixedVector2Internal(fixed(p_x), fixed(p_y)));
+	object->internal->set_transform(t);
+}
+
+void SGPhysics2DServer::collision_object_set_rotation(RID p_object, int64_t p_rotation) {
+	CollisionObjectData *object = collision_object_owner.getornull(p_object);
+	ERR_FAIL_COND(!object);
+
+	SGFixedTransform2DInternal t = object->internal->get_transform();
+	t.set_rotation_and_scale(fixed(p_rotation), t.get_scale());
+	object->internal->set_transform(t);
+}
+
+void SGPhysics2DServer::collision_objects_set_positions(const Array &p_objects, const Array &p_positions) {
+	ERR_FAIL_COND_MSG(p_positions.size() != p_objects.size() * 2, "There must be an x and y position for each object.");
+
+	Vector<SGWorld2DInternal *> worlds;
+	for (int i = 0; i < p_objects.size(); i++) {
+		CollisionObjectData *object = collision_object_owner.getornull(p_objects[i]);
+		if (!object) {
+			ERR_PRINT("Invalid RID.");
+			continue;
+		}
+		SGWorld2DInternal *world = get_object_world(object);
+		if (worlds.find(world) == -1) {
+			world->begin_batch_update();
+			worlds.push_back(world);
+		}
+		SGFixedTransform2DInternal t = object->internal->get_transform();
+		t.set_origin(SGFixedVector2Internal(fixed((int64_t)p_positions[i * 2]), fixed((int64_t)p_positions[i * 2 + 1])));
+		object->internal->set_transform(t);
+	}
+	for (int i = 0; i < worlds.size(); i++) {
+		worlds[i]->end_batch_update();
+	}
+}
+
+void SGPhysics2DServer::collision_object_set_collision_layer(RID p_object, uint32_t p_collision_layer) {
+	CollisionObjectData *object = collision_object_owner.getornull(p_object);
+	ERR_FAIL_COND(!object);
+	object->internal->set_collision_layer(p_collision_layer);
+}
+
+void SGPhysics2DServer::collision_object_set_collision_mask(RID p_object, uint32_t p_collision_mask) {
+	CollisionObjectData *object = collision_object_owner.getornull(p_object);
+	ERR_FAIL_COND(!object);
+	object->internal->set_collision_mask(p_collision_mask);
+}
+
+class SGServerOverlappingResultHandler : public SGResultHandlerInternal {
+public:
+
+	Vector<SGCollisionObject2DInternal *> result;
+
+	void handle_result(SGCollisionObject2DInternal *p_object) {
+		result.push_back(p_object);
+	}
+
+};
+
+// Nodes are returned as themselves, and objects created through the server
+// as their RID.
+Array SGPhysics2DServer::get_overlapping(SGCollisionObject2DInternal *p_internal, SGWorld2DInternal *p_world, bool p_areas, bool p_sort) const {
+	SGServerOverlappingResultHandler result_handler;
+	if (p_areas) {
+		p_world->get_overlapping_areas(p_internal, &result_handler);
+	}
+	else {
+		p_world->get_overlapping_bodies(p_internal, &result_handler);
+	}
+
+	int count = result_handler.result.size();
+	if (p_sort && count > 1) {
+		Vector<SGCollisionObject2DInternal *> scratch;
+		scratch.resize(count);
+		SGCollisionObject2DInternal::sort_by_id(result_handler.result.ptrw(), scratch.ptrw(), count);
+	}
+
+	Array result;
+	result.resize(count);
+	for (int i = 0; i < count; i++) {
+		SGCollisionObject2DInternal *object = result_handler.result[i];
+		if (object->get_data()) {
+			result[i] = (Object *)object->get_data();
+		}
+		else {
+			result[i] = object->get_rid();
+		}
+	}
+	return result;
+}
+
+Array SGPhysics2DServer::area_get_overlapping_areas(RID p_area, bool p_sort) const {
+	CollisionObjectData *object = collision_object_owner.getornull(p_area);
+	ERR_FAIL_COND_V(!object, Array());
+	ERR_FAIL_COND_V(object->internal->get_object_type() != SGCollisionObject2DInternal::OBJECT_AREA, Array());
+	return get_overlapping(object->internal, get_object_world(object), true, p_sort);
+}
+
+Array SGPhysics2DServer::area_get_overlapping_bodies(RID p_area, bool p_sort) const {
+	CollisionObjectData *object = collision_object_owner.getornull(p_area);
+	ERR_FAIL_COND_V(!object, Array());
+	ERR_FAIL_COND_V(object->internal->get_object_type() != SGCollisionObject2DInternal::OBJECT_AREA, Array());
+	return get_overlapping(object->internal, get_object_world(object), false, p_sort);
+}
+
+RID SGPhysics2DServer::world_create() {
+	WorldData *world = memnew(WorldData);
+	world->internal = memnew(SGWorld2DInternal);
+	world->object_count = 0;
+	register_world(world->internal);
+	world->ray_collision_mask = 1;
+	return world_owner.make_rid(world);
+}
+
+void SGPhysics2DServer::world_queue_positions(RID p_world, const Array &p_objects, const Array &p_positions) {
+	WorldData *world = world_owner.getornull(p_world);
+	ERR_FAIL_COND_MSG(!world, "Invalid world RID.");
+	ERR_FAIL_COND_MSG(p_positions.size() != p_objects.size() * 2, "There must be an x and y position for each object.");
+
+	for (int i = 0; i < p_objects.size(); i++) {
+		CollisionObjectData *object = collision_object_owner.getornull(p_objects[i]);
+		if (!object || object->world != world) {
+			ERR_PRINT("Invalid RID, or the object isn't in this world.");
+			continue;
+		}
+		world->queued_objects.push_back(object->internal);
+		world->queued_positions.push_back(SGFixedVector2Internal(fixed((int64_t)p_positions[i * 2]), fixed((int64_t)p_positions[i * 2 + 1])));
+	}
+}
+
+void SGPhysics2DServer::world_queue_motions(RID p_world, const Array &p_bodies, const Array &p_motions, int p_max_slides) {
+	WorldData *world = world_owner.getornull(p_world);
+	ERR_FAIL_COND_MSG(!world, "Invalid world RID.");
+	ERR_FAIL_COND_MSG(p_motions.size() != p_bodies.size() * 2, "There must be an x and y motion for each body.");
+
+	for (int i = 0; i < p_bodies.size(); i++) {
+		CollisionObjectData *object = collision_object_owner.getornull(p_bodies[i]);
+		if (!object || object->world != world) {
+			ERR_PRINT("Invalid RID, or the body isn't in this world.");
+			continue;
+		}
+		if (object->internal->get_object_type() != SGCollisionObject2DInternal::OBJECT_BODY || ((SGBody2DInternal *)object->internal)->get_body_type() != SGBody2DInternal::BODY_KINEMATIC) {
+			ERR_PRINT("Only kinematic bodies can be moved.");
+			continue;
+		}
+		world->queued_motion_bodies.push_back(object->internal);
+		world->queued_motions.push_back(SGFixedVector2Internal(fixed((int64_t)p_motions[i * 2]), fixed((int64_t)p_motions[i * 2 + 1])));
+		world->queued_max_slides.push_back(p_max_slides);
+	}
+}
+
+Dictionary SGPhysics2DServer::world_get_motion_results(RID p_world) const {
+	WorldData *world = world_owner.getornull(p_world);
+	ERR_FAIL_COND_V_MSG(!world, Dictionary(), "Invalid world RID.");
+
+	int count = world->motion_result_bodies.size();
+	Array bodies;
+	Array positions;
+	Array remainders;
+	bodies.resize(count);
+	positions.resize(count * 2);
+	remainders.resize(count * 2);
+
+	for (int i = 0; i < count; i++) {
+		bodies[i] = world->motion_result_bodies[i];
+		positions[i * 2] = world->motion_result_positions[i].x.value;
+		positions[i * 2 + 1] = world->motion_result_positions[i].y.value;
+		remainders[i * 2] = world->motion_result_remainders[i].x.value;
+		remainders[i * 2 + 1] = world->motion_result_remainders[i].y.value;
+	}
+
+	Dictionary result;
+	result["bodies"] = bodies;
+	result["positions"] = positions;
+	result["remainders"] = remainders;
+	return result;
+}
+
+void SGPhysics2DServer::world_set_monitored_areas(RID p_world, const Array &p_areas) {
+	WorldData *world = world_owner.getornull(p_world);
+	ERR_FAIL_COND_MSG(!world, "Invalid world RID.");
+
+	world->monitored_areas.clear();
+	for (int i = 0; i < p_areas.size(); i++) {
+		CollisionObjectData *object = collision_object_owner.getornull(p_areas[i]);
+		if (!object || object->world != world || object->internal->get_object_type() != SGCollisionObject2DInternal::OBJECT_AREA) {
+			ERR_PRINT("Invalid RID, or the area isn't in this world.");
+			continue;
+		}
+		world->monitored_areas.push_back(object->internal);
+	}
+}
+
+Dictionary SGPhysics2DServer::world_get_area_overlaps(RID p_world) const {
+	WorldData *world = world_owner.getornull(p_world);
+	ERR_FAIL_COND_V_MSG(!world, Dictionary(), "Invalid world RID.");
+
+	Dictionary result;
+	for (int i = 0; i < world->area_result_areas.size(); i++) {
+		const Vector<RID> &bodies = world->area_result_bodies[i];
+		Array overlapping;
+		overlapping.resize(bodies.size());
+		for (int j = 0; j < bodies.size(); j++) {
+			overlapping[j] = bodies[j];
+		}
+		result[world->area_result_areas[i]] = overlapping;
+	}
+	return result;
+}
+
+void SGPhysics2DServer::world_set_ray_casts(RID p_world, const Array &p_starts, const Array &p_cast_tos, uint32_t p_collision_mask) {
+	WorldData *world = world_owner.getornull(p_world);
+	ERR_FAIL_COND_MSG(!world, "Invalid world RID.");
+	ERR_FAIL_COND_MSG(p_starts.size() % 2 != 0 || p_starts.size() != p_cast_tos.size(), "There must be an x and y start and cast to for each ray.");
+
+	int count = p_starts.size() / 2;
+	world->ray_starts.resize(count);
+	world->ray_cast_tos.resize(count);
+	world->ray_collision_mask = p_collision_mask;
+
+	for (int i = 0; i < count; i++) {
+		world->ray_starts.write[i] = SGFixedVector2Internal(fixed((int64_t)p_starts[i * 2]), fixed((int64_t)p_starts[i * 2 + 1]));
+		world->ray_cast_tos.write[i] = SGFixedVector2Internal(fixed((int64_t)p_cast_tos[i * 2]), fixed((int64_t)p_cast_tos[i * 2 + 1]));
+	}
+}
+
+Dictionary SGPhysics2DServer::world_get_ray_results(RID p_world) const {
+	WorldData *world = world_owner.getornull(p_world);
+	ERR_FAIL_COND_V_MSG(!world, Dictionary(), "Invalid world RID.");
+
+	int count = world->ray_results.size();
+	Array colliders;
+	Array points;
+	Array normals;
+	colliders.resize(count);
+	points.resize(count * 2);
+	normals.resize(count * 2);
+
+	for (int i = 0; i < count; i++) {
+		const SGWorld2DInternal::RayCastInfo &info = world->ray_results[i];
+		if (world->ray_result_colliders[i].is_valid()) {
+			colliders[i] = world->ray_result_colliders[i];
+		}
+		points[i * 2] = info.collision_point.x.value;
+		points[i * 2 + 1] = info.collision_point.y.value;
+		normals[i * 2] = info.collision_normal.x.value;
+		normals[i * 2 + 1] = info.collision_normal.y.value;
+	}
+
+	Dictionary result;
+	result["colliders"] = colliders;
+	result["points"] = points;
+	result["normals"] = normals;
+	return result;
+}
+
+// Runs on a worker thread, so it must only touch the world at p_index.
+void SGPhysics2DServer::_step_world(uint32_t p_index, void *p_worlds) {
+	WorldData *world = ((WorldData **)p_worlds)[p_index];
+
+	if (world->queued_objects.size() > 0) {
+		world->internal->begin_batch_update();
+		for (int i = 0; i < world->queued_objects.size(); i++) {
+			SGCollisionObject2DInternal *object = world->queued_objects[i];
+			SGFixedTransform2DInternal t = object->get_transform();
+			t.set_origin(world->queued_positions[i]);
+			object->set_transform(t);
+		}
+		world->internal->end_batch_update();
+		world->queued_objects.clear();
+		world->queued_positions.clear();
+	}
+
+	// Bodies are moved in the order they were queued, so each one sees where
+	// the ones before it ended up.
+	int motion_count = world->queued_motion_bodies.size();
+	world->motion_result_bodies.resize(motion_count);
+	world->motion_result_positions.resize(motion_count);
+	world->motion_result_remainders.resize(motion_count);
+	for (int i = 0; i < motion_count; i++) {
+		SGCollisionObject2DInternal *body = world->queued_motion_bodies[i];
+		SGFixedVector2Internal remainder = world->internal->move_and_slide(body, world->queued_motions[i], world->queued_max_slides[i], &SGCollisionObject2DInternal::compare_ids);
+		world->motion_result_bodies.write[i] = body->get_rid();
+		world->motion_result_positions.write[i] = body->get_transform().get_origin();
+		world->motion_result_remainders.write[i] = remainder;
+	}
+	world->queued_motion_bodies.clear();
+	world->queued_motions.clear();
+	world->queued_max_slides.clear();
+
+	// Then, the areas are checked against where everything ended up.
+	int area_count = world->monitored_areas.size();
+	world->area_result_areas.resize(area_count);
+	world->area_result_bodies.resize(area_count);
+	for (int i = 0; i < area_count; i++) {
+		SGCollisionObject2DInternal *area = world->monitored_areas[i];
+		SGServerOverlappingResultHandler result_handler;
+		world->internal->get_overlapping_bodies(area, &result_handler);
+
+		int count = result_handler.result.size();
+		if (count > 1) {
+			Vector<SGCollisionObject2DInternal *> scratch;
+			scratch.resize(count);
+			SGCollisionObject2DInternal::sort_by_id(result_handler.result.ptrw(), scratch.ptrw(), count);
+		}
+
+		Vector<RID> &bodies = world->area_result_bodies.write[i];
+		bodies.resize(count);
+		for (int j = 0; j < count; j++) {
+			bodies.write[j] = result_handler.result[j]->get_rid();
+		}
+		world->area_result_areas.write[i] = area->get_rid();
+	}
+
+	world->internal->cast_rays(world->ray_starts, world->ray_cast_tos, world->ray_collision_mask, nullptr, world->ray_results);
+	int ray_count = world->ray_results.size();
+	world->ray_result_colliders.resize(ray_count);
+	for (int i = 0; i < ray_count; i++) {
+		SGBody2DInternal *body = world->ray_results[i].body;
+		world->ray_result_colliders.write[i] = body ? body->get_rid() : RID();
+	}
+}
+
+void SGPhysics2DServer::worlds_step(const Array &p_worlds) {
+	Vector<WorldData *> worlds;
+	for (int i = 0; i < p_worlds.size(); i++) {
+		WorldData *world = world_owner.getornull(p_worlds[i]);
+		ERR_FAIL_COND_MSG(!world, "Invalid world RID.");
+		ERR_FAIL_COND_MSG(worlds.find(world) != -1, "The same world can't be stepped twice at once.");
+		worlds.push_back(world);
+	}
+
+	// Worlds don't share any state, so each can be stepped on its own thread.
+	// The calling thread takes part too, so it needs one fewer worker.
+	if (!world_step_pool.is_initialized()) {
+		world_step_pool.init(worlds_get_thread_count());
+	}
+	world_step_pool.run(worlds.size(), &SGPhysics2DServer::_step_world, worlds.ptrw());
+}
+
+void SGPhysics2DServer::worlds_set_thread_count(int p_thread_count) {
+	ERR_FAIL_COND_MSG(p_thread_count < -1, "The thread count must be -1 or more.");
+	world_step_thread_count = p_thread_count;
+	// The pool is started again, with the new count, the next time worlds
+	// are stepped.
+	world_step_pool.finish();
+}
+
+int SGPhysics2DServer::worlds_get_thread_count() const {
+	if (world_step_thread_count == -1) {
+		return MAX(OS::get_singleton()->get_processor_count() - 1, 0);
+	}
+	return world_step_thread_count;
+}
+
+struct SGCollisionObjectIdComparator {
+	_FORCE_INLINE_ bool operator()(const SGCollisionObject2D *p_a, const SGCollisionObject2D *p_b) const {
+		return p_a->get_internal()->get_id() < p_b->get_internal()->get_id();
+	}
+};
+
+void SGPhysics2DServer::sync_all_dirty() {
+	if (dirty_collision_objects.first() == nullptr) {
+		return;
+	}
+
+	// The order that objects are synced in affects the order they're found
+	// in the broadphase, so it needs to be the same on every client, rather
+	// than the order they happened to change in.
+	Vector<SGCollisionObject2D *> objects;
+	while (dirty_collision_objects.first()) {
+		SelfList<SGCollisionObject2D> *item = dirty_collision_objects.first();
+		dirty_collision_objects.remove(item);
+		objects.push_back(item->self());
+	}
+	objects.sort_custom<SGCollisionObjectIdComparator>();
+
+	// Objects can be spread across several worlds, so batch each of them.
+	Vector<SGWorld2DInternal *> worlds;
+	for (int i = 0; i < objects.size(); i++) {
+		SGWorld2DInternal *world = objects[i]->get_world_internal();
+		if (worlds.find(world) == -1) {
+			world->begin_batch_update();
+			worlds.push_back(world);
+		}
+		objects[i]->sync_to_physics_engine();
+	}
+	for (int i = 0; i < worlds.size(); i++) {
+		worlds[i]->end_batch_update();
+	}
+
+	collision_object_sync_count += objects.size();
+}
+
+// Static bodies can only be merged with others that share the same parent
+// and collision settings.
+struct SGStaticBodyMergeGroup {
+	Node *parent;
+	const SGWorld2DInternal *world;
+	uint32_t collision_layer;
+	uint32_t collision_mask;
+	Vector<SGStaticBody2D *> bodies;
+	Vector<SGCollisionShape2D *> shapes;
+	Vector<SGFixedRect2Internal> rects;
+};
+
+static SGCollisionShape2D *_get_mergeable_shape(SGStaticBody2D *p_body) {
+	// Bodies that are removed are freed along with all their children, so
+	// only bodies with nothing else under them (ex. sprites) can be merged.
+	if (p_body->get_child_count() != 1) {
+		return nullptr;
+	}
+
+	SGCollisionShape2D *collision_shape = Object::cast_to<SGCollisionShape2D>(p_body->get_child(0));
+	if (!collision_shape || collision_shape->get_child_count() > 0 || collision_shape->get_disabled()) {
+		return nullptr;
+	}
+
+	Ref<SGRectangleShape2D> rectangle = collision_shape->get_shape();
+	if (!rectangle.is_valid()) {
+		return nullptr;
+	}
+
+	// Only unrotated and unscaled rectangles can be merged exactly.
+	const SGFixedVector2Internal x_axis(fixed::ONE, fixed::ZERO);
+	const SGFixedVector2Internal y_axis(fixed::ZERO, fixed::ONE);
+	SGFixedTransform2DInternal body_transform = p_body->get_global_fixed_transform_internal();
+	SGFixedTransform2DInternal shape_transform = collision_shape->get_fixed_transform_internal();
+	if (!(body_transform.elements[0] == x_axis && body_transform.elements[1] == y_axis)) {
+		return nullptr;
+	}
+	if (!(shape_transform.elements[0] == x_axis && shape_transform.elements[1] == y_axis)) {
+		return nullptr;
+	}
+
+	return collision_shape;
+}
+
+Dictionary SGPhysics2DServer::merge_static_bodies(const Array &p_bodies) {
+	Vector<SGStaticBodyMergeGroup> groups;
+	for (int i = 0; i < p_bodies.size(); i++) {
+		Object *obj = p_bodies[i];
+		SGStaticBody2D *body = Object::cast_to<SGStaticBody2D>(obj);
+		if (!body) {
+			continue;
+		}
+		SGCollisionShape2D *collision_shape = _get_mergeable_shape(body);
+		if (!collision_shape) {
+			continue;
+		}
+
+		Ref<SGRectangleShape2D> rectangle = collision_shape->get_shape();
+		SGFixedVector2Internal extents = rectangle->get_extents()->get_internal();
+		SGFixedVector2Internal center = body->get_global_fixed_transform_internal().get_origin() + collision_shape->get_fixed_transform_internal().get_origin();
+		SGFixedRect2Internal rect(center - extents, extents * fixed::TWO);
+
+		int group_index = -1;
+		for (int j = 0; j < groups.size(); j++) {
+			const SGStaticBodyMergeGroup &group = groups[j];
+			if (group.parent == body->get_parent() && group.collision_layer == body->get_collision_layer() && group.collision_mask == body->get_collision_mask()) {
+				group_index = j;
+				break;
+			}
+		}
+		if (group_index == -1) {
+			SGStaticBodyMergeGroup group;
+			group.parent = body->get_parent();
+			group.world = SGWorld2D::find_world_internal(body);
+			group.collision_layer = body->get_collision_layer();
+			group.collision_mask = body->get_collision_mask();
+			groups.push_back(group);
+			group_index = groups.size() - 1;
+		}
+
+		SGStaticBodyMergeGroup &group = groups.write[group_index];
+		group.bodies.push_back(body);
+		group.shapes.push_back(collision_shape);
+		group.rects.push_back(rect);
+	}
+
+	int shapes_before = 0;
+	int shapes_after = 0;
+	int cells_before = 0;
+	int cells_after = 0;
+
+	for (int i = 0; i < groups.size(); i++) {
+		const SGStaticBodyMergeGroup &group = groups[i];
+		const SGBroadphase2DInternal *broadphase = group.world->get_broadphase();
+
+		Vector<int> source_map;
+		Vector<SGFixedRect2Internal> merged = SGRectangleMerger2DInternal::merge(group.rects, &source_map);
+
+		shapes_before += group.rects.size();
+		shapes_after += merged.size();
+		for (int j = 0; j < group.rects.size(); j++) {
+			cells_before += broadphase->get_cell_count(group.rects[j]);
+		}
+		for (int j = 0; j < merged.size(); j++) {
+			cells_after += broadphase->get_cell_count(merged[j]);
+		}
+
+		// The first body that went into each merged rectangle is kept and
+		// resized, and the rest are removed.
+		Vector<SGStaticBody2D *> keepers;
+		keepers.resize(merged.size());
+		for (int j = 0; j < merged.size(); j++) {
+			keepers.write[j] = nullptr;
+		}
+		for (int j = 0; j < source_map.size(); j++) {
+			int merged_index = source_map[j];
+			SGStaticBody2D *body = group.bodies[j];
+
+			if (keepers[merged_index] == nullptr) {
+				keepers.write[merged_index] = body;
+
+				const SGFixedRect2Internal &rect = merged[merged_index];
+				SGFixedVector2Internal extents = rect.size / fixed::TWO;
+				SGFixedVector2Internal center = rect.position + extents;
+
+				Ref<SGRectangleShape2D> rectangle;
+				rectangle.instance();
+				rectangle->set_extents(SGFixedVector2::from_internal(extents));
+
+				SGCollisionShape2D *collision_shape = group.shapes[j];
+				collision_shape->set_shape(rectangle);
+				collision_shape->set_fixed_position_internal(center - body->get_global_fixed_transform_internal().get_origin());
+				body->sync_to_physics_engine();
+			}
+			else {
+				Node *parent = body->get_parent();
+				if (parent) {
+					parent->remove_child(body);
+				}
+				body->queue_delete();
+			}
+		}
+	}
+
+	Dictionary result;
+	result["shapes_before"] = shapes_before;
+	result["shapes_after"] = shapes_after;
+	result["broadphase_cells_before"] = cells_before;
+	result["broadphase_cells_after"] = cells_after;
+	return result;
+}
+
+Dictionary SGPhysics2DServer::move_and_slide_bodies(const Array &p_bodies, const Array &p_velocities, int p_max_slides) {
+	ERR_FAIL_COND_V_MSG(p_velocities.size() != p_bodies.size() * 2, Dictionary(), "There must be an x and y velocity for each body.");
+
+	Vector<SGKinematicBody2D *> bodies;
+	bodies.resize(p_bodies.size());
+	for (int i = 0; i < p_bodies.size(); i++) {
+		Object *obj = p_bodies[i];
+		SGKinematicBody2D *body = Object::cast_to<SGKinematicBody2D>(obj);
+		ERR_FAIL_COND_V_MSG(!body, Dictionary(), "Only SGKinematicBody2D's can be moved.");
+		bodies.write[i] = body;
+	}
+
+	// These are plain Arrays rather than PoolIntArrays, because the latter
+	// only hold 32-bit integers, and fixed-point values need all 64 bits.
+	Array positions;
+	Array velocities;
+	positions.resize(p_velocities.size());
+	velocities.resize(p_velocities.size());
+
+	// Bodies are moved in the order given, so each one sees where the ones
+	// before it ended up. Each node is updated just like it would be by its
+	// own move_and_slide(), including snapping the physics engine to what
+	// the node can represent after every collision, so the results are the
+	// same as moving them one at a time.
+	for (int i = 0; i < bodies.size(); i++) {
+		SGFixedVector2Internal velocity(fixed((int64_t)p_velocities[i * 2]), fixed((int64_t)p_velocities[i * 2 + 1]));
+		SGFixedVector2Internal remainder = bodies[i]->move_and_slide(velocity, p_max_slides);
+		velocities[i * 2] = remainder.x.value;
+		velocities[i * 2 + 1] = remainder.y.value;
+
+		SGFixedVector2Internal position = bodies[i]->get_global_fixed_transform_internal().get_origin();
+		positions[i * 2] = position.x.value;
+		positions[i * 2 + 1] = position.y.value;
+	}
+
+	Dictionary result;
+	result["positions"] = positions;
+	result["velocities"] = velocities;
+	return result;
+}
+
+SGWorld2DInternal *SGPhysics2DServer::_get_world_internal(const Variant &p_world) const {
+	if (p_world.get_type() == Variant::NIL) {
+		return default_world;
+	}
+	if (p_world.get_type() == Variant::_RID) {
+		WorldData *world = world_owner.getornull(p_world);
+		ERR_FAIL_COND_V_MSG(!world, nullptr, "Invalid world RID.");
+		return world->internal;
+	}
+
+	Object *obj = p_world;
+	Node *node = Object::cast_to<Node>(obj);
+	ERR_FAIL_COND_V_MSG(!node, nullptr, "The world must be a world RID or a node.");
+	SGWorld2D *world_node = Object::cast_to<SGWorld2D>(node);
+	if (world_node) {
+		return world_node->get_internal();
+	}
+	return SGWorld2D::find_world_internal(node);
+}
+
+Dictionary SGPhysics2DServer::cast_shape(const Ref<SGShape2D> &p_shape, const Ref<SGFixedTransform2D> &p_transform, const Ref<SGFixedVector2> &p_motion, uint32_t p_collision_mask, const Array &p_exceptions, const Variant &p_world) {
+	ERR_FAIL_COND_V(!p_shape.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(!p_transform.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(!p_motion.is_valid(), Dictionary());
+
+	SGWorld2DInternal *world = _get_world_internal(p_world);
+	if (!world) {
+		return Dictionary();
+	}
+
+	Set<SGCollisionObject2DInternal *> exceptions;
+	for (int i = 0; i < p_exceptions.size(); i++) {
+		if (p_exceptions[i].get_type() == Variant::_RID) {
+			CollisionObjectData *object = collision_object_owner.getornull(p_exceptions[i]);
+			if (object) {
+				exceptions.insert(object->internal);
+			}
+			continue;
+		}
+		Object *obj = p_exceptions[i];
+		SGCollisionObject2D *collision_object = Object::cast_to<SGCollisionObject2D>(obj);
+		if (collision_object) {
+			exceptions.insert(collision_object->get_internal());
+		}
+	}
+
+	SGShape2DInternal *internal_shape = p_shape->create_internal_shape();
+	p_shape->sync_to_physics_engine(internal_shape);
+
+	SGWorld2DInternal::ShapeCastInfo info;
+	bool colliding = world->cast_shape(internal_shape, p_transform->get_internal(), p_motion->get_internal(), p_collision_mask, &exceptions, &info);
+	memdelete(internal_shape);
+
+	Dictionary result;
+	if (colliding) {
+		if (info.collider->get_data()) {
+			result["collider"] = (Object *)info.collider->get_data();
+		}
+		else {
+			result["collider"] = info.collider->get_rid();
+		}
+		result["fraction"] = info.fraction.value;
+		result["point"] = SGFixedVector2::from_internal(info.collision_point);
+		result["normal"] = SGFixedVector2::from_internal(info.collision_normal);
+	}
+	return result;
+}
@@ -0,0 +1,210 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SG_PHYSICS_2D_SERVER_H
+#define SG_PHYSICS_2D_SERVER_H
+
+#include <core/hash_map.h>
+#include <core/object.h>
+#include <core/rid.h>
+#include <core/self_list.h>
+#include <core/set.h>
+
+#include "../math/sg_fixed_vector2.h"
+#include "../math/sg_fixed_transform_2d.h"
+#include "../scene/resources/sg_shapes_2d.h"
+#include "../internal/sg_world_2d_internal.h"
+#include "sg_thread_pool.h"
+
+class SGFixedNode2D;
+class SGCollisionObject2D;
+class SGCollisionObject2DInternal;
+
+class SGPhysics2DServer : public Object {
+
+	GDCLASS(SGPhysics2DServer, Object);
+
+	static SGPhysics2DServer *singleton;
+
+	SelfList<SGFixedNode2D>::List dirty_float_transforms;
+	uint64_t float_transform_sync_count;
+
+	SelfList<SGCollisionObject2D>::List dirty_collision_objects;
+	uint64_t collision_object_sync_count;
+
+	int64_t next_object_id;
+	// The object using each id, for everything that's in the scene tree or
+	// was created through the server.
+	HashMap<int64_t, SGCollisionObject2DInternal *> live_object_ids;
+
+	// Used by everything that isn't in a world of its own.
+	SGWorld2DInternal *default_world;
+
+	// Every other world, whether it was created through the server or by an
+	// SGWorld2D, so that process info can be gathered from all of them.
+	Set<SGWorld2DInternal *> worlds;
+
+	// A world created through the server, along with the work waiting for
+	// the next time it's stepped.
+	struct WorldData : public RID_Data {
+		SGWorld2DInternal *internal;
+		int object_count;
+
+		Vector<SGCollisionObject2DInternal *> queued_objects;
+		Vector<SGFixedVector2Internal> queued_positions;
+
+		Vector<SGCollisionObject2DInternal *> queued_motion_bodies;
+		Vector<SGFixedVector2Internal> queued_motions;
+		Vector<int> queued_max_slides;
+		Vector<RID> motion_result_bodies;
+		Vector<SGFixedVector2Internal> motion_result_positions;
+		Vector<SGFixedVector2Internal> motion_result_remainders;
+
+		Vector<SGCollisionObject2DInternal *> monitored_areas;
+		Vector<RID> area_result_areas;
+		Vector<Vector<RID> > area_result_bodies;
+
+		Vector<SGFixedVector2Internal> ray_starts;
+		Vector<SGFixedVector2Internal> ray_cast_tos;
+		uint32_t ray_collision_mask;
+		Vector<SGWorld2DInternal::RayCastInfo> ray_results;
+		// The bodies the rays hit are kept as RIDs, since they can be freed
+		// before the results are read.
+		Vector<RID> ray_result_colliders;
+	};
+	mutable RID_Owner<WorldData> world_owner;
+
+	// A collision object created directly through the server, without a node.
+	struct CollisionObjectData : public RID_Data {
+		SGCollisionObject2DInternal *internal;
+		WorldData *world;
+	};
+	mutable RID_Owner<CollisionObjectData> collision_object_owner;
+
+	RID collision_object_create(SGCollisionObject2DInternal *p_internal, RID p_world);
+	_FORCE_INLINE_ SGWorld2DInternal *get_object_world(const CollisionObjectData *p_object) const {
+		return p_object->world ? p_object->world->internal : default_world;
+	}
+	Array get_overlapping(SGCollisionObject2DInternal *p_internal, SGWorld2DInternal *p_world, bool p_areas, bool p_sort) const;
+
+	// Started the first time worlds are stepped, and kept for reuse.
+	SGThreadPool world_step_pool;
+	// -1 means one fewer than the number of processors.
+	int world_step_thread_count;
+	static void _step_world(uint32_t p_index, void *p_worlds);
+
+	// Gets the world from a world RID, or a node (using the world it's in),
+	// or the default world if it's null.
+	SGWorld2DInternal *_get_world_internal(const Variant &p_world) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	enum ProcessInfo {
+		INFO_PREFILTER_TESTS,
+		INFO_PREFILTER_REJECTIONS,
+		INFO_SEPARATING_AXIS_CACHE_HITS,
+		INFO_FIXED_VECTOR2_ALLOCATIONS,
+		INFO_FLOAT_TRANSFORM_SYNCS,
+		INFO_COLLISION_OBJECT_SYNCS,
+	};
+
+	enum BodyType {
+		BODY_STATIC,
+		BODY_KINEMATIC,
+	};
+
+	static SGPhysics2DServer *get_singleton();
+
+	int64_t get_process_info(ProcessInfo p_info) const;
+	void reset_process_info();
+
+	int64_t allocate_object_id();
+	// Marks the object's id as in use, so it won't be handed out again. If it
+	// doesn't have one yet, or another live object already has it, it's
+	// given a new one.
+	void register_object_id(SGCollisionObject2DInternal *p_object);
+	void unregister_object_id(SGCollisionObject2DInternal *p_object);
+	// Gives a live object a new id, even if another live object has it, so
+	// that ids can be swapped.
+	void change_object_id(SGCollisionObject2DInternal *p_object, int64_t p_object_id);
+	void set_next_object_id(int64_t p_next_object_id);
+	int64_t get_next_object_id() const;
+
+	_FORCE_INLINE_ SGWorld2DInternal *get_default_world() const { return default_world; }
+	void register_world(SGWorld2DInternal *p_world);
+	void unregister_world(SGWorld2DInternal *p_world);
+
+	RID world_create();
+	void world_queue_positions(RID p_world, const Array &p_objects, const Array &p_positions);
+	void world_queue_motions(RID p_world, const Array &p_bodies, const Array &p_motions, int p_max_slides = 4);
+	Dictionary world_get_motion_results(RID p_world) const;
+	void world_set_monitored_areas(RID p_world, const Array &p_areas);
+	Dictionary world_get_area_overlaps(RID p_world) const;
+	void world_set_ray_casts(RID p_world, const Array &p_starts, const Array &p_cast_tos, uint32_t p_collision_mask = 1);
+	Dictionary world_get_ray_results(RID p_world) const;
+	void worlds_step(const Array &p_worlds);
+	void worlds_set_thread_count(int p_thread_count);
+	int worlds_get_thread_count() const;
+
+	RID area_create(RID p_world = RID());
+	RID body_create(BodyType p_body_type = BODY_KINEMATIC, RID p_world = RID());
+	void free_rid(RID p_rid);
+
+	void collision_object_add_rectangle_shape(RID p_object, int64_t p_extents_x, int64_t p_extents_y, int64_t p_offset_x = 0, int64_t p_offset_y = 0);
+	void collision_object_add_circle_shape(RID p_object, int64_t p_radius, int64_t p_offset_x = 0, int64_t p_offset_y = 0);
+	void collision_object_clear_shapes(RID p_object);
+
+	void collision_object_set_position(RID p_object, int64_t p_x, int64_t p_y);
+	void collision_object_set_rotation(RID p_object, int64_t p_rotation);
+	void collision_objects_set_positions(const Array &p_objects, const Array &p_positions);
+
+	void collision_object_set_collision_layer(RID p_object, uint32_t p_collision_layer);
+	void collision_object_set_collision_mask(RID p_object, uint32_t p_collision_mask);
+
+	Array area_get_overlapping_areas(RID p_area, bool p_sort = true) const;
+	Array area_get_overlapping_bodies(RID p_area, bool p_sort = true) const;
+
+	Dictionary merge_static_bodies(const Array &p_bodies);
+
+	Dictionary move_and_slide_bodies(const Array &p_bodies, const Array &p_velocities, int p_max_slides = 4);
+
+	Dictionary cast_shape(const Ref<SGShape2D> &p_shape, const Ref<SGFixedTransform2D> &p_transform, const Ref<SGFixedVector2> &p_motion, uint32_t p_collision_mask = 1, const Array &p_exceptions = Array(), const Variant &p_world = Variant());
+
+	void add_dirty_float_transform(SelfList<SGFixedNode2D> *p_item);
+	void remove_dirty_float_transform(SelfList<SGFixedNode2D> *p_item);
+	void flush_float_transforms();
+
+	void add_dirty_collision_object(SelfList<SGCollisionObject2D> *p_item);
+	void remove_dirty_collision_object(SelfList<SGCollisionObject2D> *p_item);
+	void sync_all_dirty();
+
+	SGPhysics2DServer();
+	~SGPhysics2DServer();
+};
+
+VARIANT_ENUM_CAST(SGPhysics2DServer::ProcessInfo);
+VARIANT_ENUM_CAST(SGPhysics2DServer::BodyType);
+
+#endif
@@ -0,0 +1,124 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "sg_thread_pool.h"
+
+#include <core/error_macros.h>
+#include <core/os/memory.h>
+
+void SGThreadPool::_thread_function(void *p_pool) {
+	SGThreadPool *pool = (SGThreadPool *)p_pool;
+	while (true) {
+		pool->start_semaphore.wait();
+		if (pool->exiting.is_set()) {
+			return;
+		}
+		pool->_process_elements();
+		pool->done_semaphore.post();
+	}
+}
+
+void SGThreadPool::_process_elements() {
+	while (true) {
+		uint32_t index = next_element.postincrement();
+		if (index >= element_count) {
+			break;
+		}
+		callback(index, userdata);
+	}
+}
+
+void SGThreadPool::init(int p_thread_count) {
+	ERR_FAIL_COND(initialized);
+
+	thread_count = MAX(p_thread_count, 0);
+	if (thread_count > 0) {
+		threads = memnew_arr(Thread, thread_count);
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].start(&SGThreadPool::_thread_function, this);
+		}
+	}
+	initialized = true;
+}
+
+void SGThreadPool::finish() {
+	if (!initialized) {
+		return;
+	}
+
+	exiting.set();
+	for (int i = 0; i < thread_count; i++) {
+		start_semaphore.post();
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	if (threads) {
+		memdelete_arr(threads);
+		threads = nullptr;
+	}
+
+	thread_count = 0;
+	exiting.clear();
+	initialized = false;
+}
+
+void SGThreadPool::run(uint32_t p_element_count, Callback p_callback, void *p_userdata) {
+	ERR_FAIL_COND(!initialized);
+
+	if (thread_count == 0 || p_element_count < 2) {
+		for (uint32_t i = 0; i < p_element_count; i++) {
+			p_callback(i, p_userdata);
+		}
+		return;
+	}
+
+	callback = p_callback;
+	userdata = p_userdata;
+	element_count = p_element_count;
+	next_element.set(0);
+
+	// The semaphores make sure the workers see the job set up above.
+	int workers = MIN((uint32_t)thread_count, p_element_count - 1);
+	for (int i = 0; i < workers; i++) {
+		start_semaphore.post();
+	}
+	_process_elements();
+	for (int i = 0; i < workers; i++) {
+		done_semaphore.wait();
+	}
+}
+
+SGThreadPool::SGThreadPool() {
+	threads = nullptr;
+	thread_count = 0;
+	initialized = false;
+	callback = nullptr;
+	userdata = nullptr;
+	element_count = 0;
+}
+
+SGThreadPool::~SGThreadPool() {
+	finish();
+}
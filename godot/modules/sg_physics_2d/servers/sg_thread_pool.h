@@ -0,0 +1,70 @@
+/*************************************************************************/
+/* Copyright (c) 2021 David Snopek                                       */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef SG_THREAD_POOL_H
+#define SG_THREAD_POOL_H
+
+#include <core/os/semaphore.h>
+#include <core/os/thread.h>
+#include <core/safe_refcount.h>
+
+// A fixed set of worker threads that are started once and reused, so that
+// running a small job every frame doesn't pay for creating threads.
+class SGThreadPool {
+public:
+	typedef void (*Callback)(uint32_t p_index, void *p_userdata);
+
+private:
+	Thread *threads;
+	int thread_count;
+	bool initialized;
+
+	Semaphore start_semaphore;
+	Semaphore done_semaphore;
+	SafeFlag exiting;
+
+	Callback callback;
+	void *userdata;
+	uint32_t element_count;
+	SafeNumeric<uint32_t> next_element;
+
+	static void _thread_function(void *p_pool);
+	void _process_elements();
+
+public:
+	_FORCE_INLINE_ bool is_initialized() const { return initialized; }
+	_FORCE_INLINE_ int get_thread_count() const { return thread_count; }
+
+	void init(int p_thread_count);
+	void finish();
+
+	// Calls p_callback once for each index up to p_element_count, spread
+	// across the workers and the calling thread, and waits for them all.
+	void run(uint32_t p_element_count, Callback p_callback, void *p_userdata);
+
+	SGThreadPool();
+	~SGThreadPool();
+};
+
+#endif
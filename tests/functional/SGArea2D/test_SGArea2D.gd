@@ -15,11 +15,22 @@ func test_get_overlapping_bodies() -> void:
 		assert_eq(result[0], scene.static_body1)
 		assert_eq(result[1], scene.static_body2)
 		
-		# Add/remove one of the bodies to change the order in the scene tree.
+		# Add/remove one of the bodies to change the order in the scene tree,
+		# which shouldn't change the order, since it keeps its object id.
 		scene.remove_child(scene.static_body1)
 		scene.add_child(scene.static_body1)
 		scene.static_body1.sync_to_physics_engine()
 		
+		result = scene.do_get_overlapping_bodies()
+		assert_eq(result.size(), 2)
+		assert_eq(result[0], scene.static_body1)
+		assert_eq(result[1], scene.static_body2)
+		
+		# Swapping the object ids does change the order.
+		var object_id = scene.static_body1.get_object_id()
+		scene.static_body1.set_object_id(scene.static_body2.get_object_id())
+		scene.static_body2.set_object_id(object_id)
+		
 		result = scene.do_get_overlapping_bodies()
 		assert_eq(result.size(), 2)
 		assert_eq(result[0], scene.static_body2)
@@ -28,3 +39,29 @@ func test_get_overlapping_bodies() -> void:
 		remove_child(scene)
 		scene.queue_free()
 
+func test_fill_overlapping_bodies() -> void:
+	var GetOverlappingBodies = load("res://tests/functional/SGArea2D/GetOverlappingBodies.tscn")
+	var scene = GetOverlappingBodies.instance()
+	add_child(scene)
+	
+	# Anything already in the array gets replaced.
+	var result := [1, 2, 3]
+	assert_eq(scene.area.fill_overlapping_bodies(result), 2)
+	assert_eq(result, [scene.static_body1, scene.static_body2])
+	
+	var object_id = scene.static_body1.get_object_id()
+	scene.static_body1.set_object_id(scene.static_body2.get_object_id())
+	scene.static_body2.set_object_id(object_id)
+	
+	assert_eq(scene.area.fill_overlapping_bodies(result), 2)
+	assert_eq(result, [scene.static_body2, scene.static_body1])
+	
+	# Instance ids are 64-bit, so they can't go in a PoolIntArray.
+	var ids = scene.area.get_overlapping_body_ids()
+	assert_typeof(ids, TYPE_ARRAY)
+	assert_eq(ids.size(), 2)
+	assert_eq(ids[0], scene.static_body2.get_instance_id())
+	assert_eq(ids[1], scene.static_body1.get_instance_id())
+	
+	remove_child(scene)
+	scene.queue_free()
@@ -0,0 +1,180 @@
+extends "res://addons/gut/test.gd"
+
+func create_area(x: int, y: int) -> SGArea2D:
+	var area = SGArea2D.new()
+	var area_shape = SGCollisionShape2D.new()
+	area_shape.shape = SGRectangleShape2D.new()
+	area_shape.shape.extents = SGFixed.vector2(SGFixed.from_int(1), SGFixed.from_int(1))
+	area.add_child(area_shape)
+	area.fixed_position = SGFixed.vector2(SGFixed.from_int(x), SGFixed.from_int(y))
+	return area
+
+func test_sync_to_physics_engine() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var body = SGStaticBody2D.new()
+	var collision_shape = SGCollisionShape2D.new()
+	collision_shape.shape = SGRectangleShape2D.new()
+	collision_shape.shape.extents = SGFixed.vector2(SGFixed.from_int(10), SGFixed.from_int(10))
+	body.add_child(collision_shape)
+	parent.add_child(body)
+	
+	var area = create_area(100, 100)
+	parent.add_child(area)
+	assert_eq(area.get_overlapping_bodies().size(), 0)
+	
+	# Only the body moves.
+	body.fixed_position = SGFixed.vector2(SGFixed.from_int(95), SGFixed.from_int(95))
+	body.sync_to_physics_engine()
+	assert_eq(area.get_overlapping_bodies().size(), 1)
+	
+	# Moving the shape relative to the body.
+	collision_shape.fixed_position = SGFixed.vector2(SGFixed.from_int(-20), 0)
+	body.sync_to_physics_engine()
+	assert_eq(area.get_overlapping_bodies().size(), 0)
+	
+	# Changing the shape itself.
+	collision_shape.shape.extents = SGFixed.vector2(SGFixed.from_int(30), SGFixed.from_int(10))
+	body.sync_to_physics_engine()
+	assert_eq(area.get_overlapping_bodies().size(), 1)
+	
+	# Adding a new shape.
+	collision_shape.disabled = true
+	body.sync_to_physics_engine()
+	assert_eq(area.get_overlapping_bodies().size(), 0)
+	var other_shape = SGCollisionShape2D.new()
+	other_shape.shape = SGRectangleShape2D.new()
+	other_shape.shape.extents = SGFixed.vector2(SGFixed.from_int(10), SGFixed.from_int(10))
+	body.add_child(other_shape)
+	body.sync_to_physics_engine()
+	assert_eq(area.get_overlapping_bodies().size(), 1)
+	
+	remove_child(parent)
+	parent.queue_free()
+
+func test_sync_all_dirty() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var bodies := []
+	for i in range(3):
+		var body = SGStaticBody2D.new()
+		var collision_shape = SGCollisionShape2D.new()
+		collision_shape.shape = SGRectangleShape2D.new()
+		collision_shape.shape.extents = SGFixed.vector2(SGFixed.from_int(10), SGFixed.from_int(10))
+		body.add_child(collision_shape)
+		parent.add_child(body)
+		bodies.append(body)
+	
+	var area = create_area(100, 100)
+	parent.add_child(area)
+	
+	SGPhysics2DServer.sync_all_dirty()
+	SGPhysics2DServer.reset_process_info()
+	
+	# Nothing has changed, so nothing should be synced.
+	SGPhysics2DServer.sync_all_dirty()
+	assert_eq(SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_COLLISION_OBJECT_SYNCS), 0)
+	
+	bodies[2].fixed_position = SGFixed.vector2(SGFixed.from_int(100), SGFixed.from_int(100))
+	bodies[0].fixed_position = SGFixed.vector2(SGFixed.from_int(95), SGFixed.from_int(95))
+	assert_eq(area.get_overlapping_bodies().size(), 0)
+	
+	SGPhysics2DServer.sync_all_dirty()
+	assert_eq(SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_COLLISION_OBJECT_SYNCS), 2)
+	var overlapping = area.get_overlapping_bodies()
+	assert_eq(overlapping.size(), 2)
+	assert_eq(overlapping[0], bodies[0])
+	assert_eq(overlapping[1], bodies[2])
+	
+	# Calling sync_to_physics_engine() directly means it's no longer dirty.
+	bodies[1].fixed_position = SGFixed.vector2(SGFixed.from_int(105), SGFixed.from_int(105))
+	bodies[1].sync_to_physics_engine()
+	SGPhysics2DServer.sync_all_dirty()
+	assert_eq(SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_COLLISION_OBJECT_SYNCS), 2)
+	assert_eq(area.get_overlapping_bodies().size(), 3)
+	
+	remove_child(parent)
+	parent.queue_free()
+
+func test_object_id() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var next_object_id = SGPhysics2DServer.get_next_object_id()
+	var area1 = create_area(0, 0)
+	var area2 = create_area(0, 0)
+	assert_eq(area1.get_object_id(), 0)
+	
+	# Ids are assigned in the order objects first enter the tree.
+	parent.add_child(area2)
+	parent.add_child(area1)
+	assert_eq(area2.get_object_id(), next_object_id)
+	assert_eq(area1.get_object_id(), next_object_id + 1)
+	assert_eq(SGPhysics2DServer.get_next_object_id(), next_object_id + 2)
+	
+	# Re-entering the tree keeps the same id.
+	parent.remove_child(area2)
+	parent.add_child(area2)
+	assert_eq(area2.get_object_id(), next_object_id)
+	
+	remove_child(parent)
+	parent.queue_free()
+
+func test_object_id_is_unique() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var area1 = create_area(0, 0)
+	parent.add_child(area1)
+	
+	# A copy gets a new id when it enters the tree.
+	var area2 = area1.duplicate()
+	assert_eq(area2.get_object_id(), area1.get_object_id())
+	parent.add_child(area2)
+	assert_ne(area2.get_object_id(), area1.get_object_id())
+	
+	# Ids that are in use are skipped, even if the counter is set back.
+	SGPhysics2DServer.set_next_object_id(area1.get_object_id())
+	var area3 = create_area(0, 0)
+	parent.add_child(area3)
+	assert_ne(area3.get_object_id(), area1.get_object_id())
+	assert_ne(area3.get_object_id(), area2.get_object_id())
+	
+	# Once an object leaves the tree, its id can be used again.
+	var object_id = area1.get_object_id()
+	parent.remove_child(area1)
+	var area4 = create_area(0, 0)
+	area4.set_object_id(object_id)
+	parent.add_child(area4)
+	assert_eq(area4.get_object_id(), object_id)
+	area1.free()
+	
+	remove_child(parent)
+	parent.queue_free()
+
+func test_object_id_is_saved() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var area = create_area(0, 0)
+	parent.add_child(area)
+	area.owner = parent
+	var object_id = area.get_object_id()
+	
+	# Saving the scene keeps the id.
+	var packed_scene = PackedScene.new()
+	assert_eq(packed_scene.pack(parent), OK)
+	var loaded = packed_scene.instance()
+	assert_eq(loaded.get_child(0).get_object_id(), object_id)
+	loaded.free()
+	
+	# An id that's loaded with a scene won't be handed out again.
+	var saved_area = create_area(0, 0)
+	saved_area.set_object_id(SGPhysics2DServer.get_next_object_id() + 100)
+	parent.add_child(saved_area)
+	assert_eq(SGPhysics2DServer.get_next_object_id(), saved_area.get_object_id() + 1)
+	
+	remove_child(parent)
+	parent.queue_free()
@@ -16,9 +16,9 @@ func test_move_and_collide_deepest_penetration() -> void:
 		assert_eq(collision.normal.x, 0)
 		assert_eq(collision.normal.y, 65536)
 		assert_eq(scene.kinematic_body.fixed_transform.origin.x, 1310720)
-		assert_eq(scene.kinematic_body.fixed_transform.origin.y, 1966592)
+		assert_eq(scene.kinematic_body.fixed_transform.origin.y, 1966082)
 		assert_eq(collision.remainder.x, 0)
-		assert_eq(collision.remainder.y, -66048)
+		assert_eq(collision.remainder.y, -65538)
 		
 		# Add/remove one of the bodies to change the order in the scene tree.
 		# It shouldn't have any effect because one shape has deeper penetration.
@@ -33,9 +33,9 @@ func test_move_and_collide_deepest_penetration() -> void:
 		assert_eq(collision.normal.x, 0)
 		assert_eq(collision.normal.y, 65536)
 		assert_eq(scene.kinematic_body.fixed_transform.origin.x, 1310720)
-		assert_eq(scene.kinematic_body.fixed_transform.origin.y, 1966592)
+		assert_eq(scene.kinematic_body.fixed_transform.origin.y, 1966082)
 		assert_eq(collision.remainder.x, 0)
-		assert_eq(collision.remainder.y, -66048)
+		assert_eq(collision.remainder.y, -65538)
 		
 		remove_child(scene)
 		scene.queue_free()
@@ -56,9 +56,9 @@ func test_move_and_collide_lowest_scene_tree() -> void:
 		assert_eq(collision.normal.x, 0)
 		assert_eq(collision.normal.y, 65536)
 		assert_eq(scene.kinematic_body.fixed_transform.origin.x, 1310720)
-		assert_eq(scene.kinematic_body.fixed_transform.origin.y, 1966592)
+		assert_eq(scene.kinematic_body.fixed_transform.origin.y, 1966082)
 		assert_eq(collision.remainder.x, 0)
-		assert_eq(collision.remainder.y, -66048)
+		assert_eq(collision.remainder.y, -65538)
 
 		# Add/remove one of the bodies to change the order in the scene tree
 		scene.remove_child(scene.static_body1)
@@ -72,9 +72,62 @@ func test_move_and_collide_lowest_scene_tree() -> void:
 		assert_eq(collision.normal.x, 0)
 		assert_eq(collision.normal.y, 65536)
 		assert_eq(scene.kinematic_body.fixed_transform.origin.x, 1310720)
-		assert_eq(scene.kinematic_body.fixed_transform.origin.y, 1966592)
+		assert_eq(scene.kinematic_body.fixed_transform.origin.y, 1966082)
 		assert_eq(collision.remainder.x, 0)
-		assert_eq(collision.remainder.y, -66048)
+		assert_eq(collision.remainder.y, -65538)
 
 		remove_child(scene)
 		scene.queue_free()
+
+func test_move_and_slide_in_place() -> void:
+	var MoveAndCollide2 = load("res://tests/functional/SGKinematicBody2D/MoveAndCollide2.tscn")
+	var scene = MoveAndCollide2.instance()
+	add_child(scene)
+	
+	var remainder = scene.kinematic_body.move_and_slide(SGFixed.vector2(65536, -SGFixed.TWO))
+	var origin = scene.kinematic_body.fixed_transform.origin.copy()
+	
+	scene.reset_kinematic_body()
+	var velocity = SGFixed.vector2(65536, -SGFixed.TWO)
+	scene.kinematic_body.move_and_slide_in_place(velocity)
+	assert_eq(velocity.x, remainder.x)
+	assert_eq(velocity.y, remainder.y)
+	assert_eq(scene.kinematic_body.fixed_transform.origin.x, origin.x)
+	assert_eq(scene.kinematic_body.fixed_transform.origin.y, origin.y)
+	
+	remove_child(scene)
+	scene.queue_free()
+
+func test_move_and_collide_circle() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var static_body = SGStaticBody2D.new()
+	var static_shape = SGCollisionShape2D.new()
+	static_shape.shape = SGRectangleShape2D.new()
+	static_shape.shape.extents = SGFixed.vector2(SGFixed.from_int(10), SGFixed.from_int(10))
+	static_body.add_child(static_shape)
+	static_body.fixed_position = SGFixed.vector2(SGFixed.from_int(30), 0)
+	parent.add_child(static_body)
+	
+	var kinematic_body = SGKinematicBody2D.new()
+	var kinematic_shape = SGCollisionShape2D.new()
+	kinematic_shape.shape = SGCircleShape2D.new()
+	kinematic_shape.shape.radius = SGFixed.from_int(10)
+	kinematic_body.add_child(kinematic_shape)
+	parent.add_child(kinematic_body)
+	
+	# Circles get the same precise point of impact as rectangles: one step
+	# of the motion short of touching.
+	var collision = kinematic_body.move_and_collide(SGFixed.vector2(SGFixed.from_int(20), 0))
+	assert_not_null(collision)
+	assert_eq(collision.collider, static_body)
+	assert_eq(collision.normal.x, -65536)
+	assert_eq(collision.normal.y, 0)
+	assert_eq(kinematic_body.fixed_transform.origin.x, 655340)
+	assert_eq(kinematic_body.fixed_transform.origin.y, 0)
+	assert_eq(collision.remainder.x, 655380)
+	assert_eq(collision.remainder.y, 0)
+	
+	remove_child(parent)
+	parent.queue_free()
@@ -0,0 +1,450 @@
+extends "res://addons/gut/test.gd"
+
+func create_static_body(x: int, y: int, extents: int) -> SGStaticBody2D:
+	var body = SGStaticBody2D.new()
+	body.fixed_position = SGFixed.vector2(SGFixed.from_int(x), SGFixed.from_int(y))
+	var collision_shape = SGCollisionShape2D.new()
+	var shape = SGRectangleShape2D.new()
+	shape.extents = SGFixed.vector2(SGFixed.from_int(extents), SGFixed.from_int(extents))
+	collision_shape.shape = shape
+	body.add_child(collision_shape)
+	return body
+
+func create_kinematic_body(x: int, y: int, extents: int) -> SGKinematicBody2D:
+	var body = SGKinematicBody2D.new()
+	body.fixed_position = SGFixed.vector2(SGFixed.from_int(x), SGFixed.from_int(y))
+	var collision_shape = SGCollisionShape2D.new()
+	var shape = SGRectangleShape2D.new()
+	shape.extents = SGFixed.vector2(SGFixed.from_int(extents), SGFixed.from_int(extents))
+	collision_shape.shape = shape
+	body.add_child(collision_shape)
+	return body
+
+func test_merge_static_bodies() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var bodies := []
+	for y in [110, 130]:
+		for x in [110, 130]:
+			var body = create_static_body(x, y, 10)
+			parent.add_child(body)
+			bodies.append(body)
+	
+	# This one is on a different layer, so it won't be merged.
+	var other_body = create_static_body(130, 150, 10)
+	other_body.collision_layer = 2
+	parent.add_child(other_body)
+	bodies.append(other_body)
+	
+	var info = SGPhysics2DServer.merge_static_bodies(bodies)
+	assert_eq(info['shapes_before'], 5)
+	assert_eq(info['shapes_after'], 2)
+	assert_eq(info['broadphase_cells_before'], 11)
+	assert_eq(info['broadphase_cells_after'], 6)
+	
+	assert_eq(parent.get_child_count(), 2)
+	assert_eq(parent.get_child(0), bodies[0])
+	assert_eq(parent.get_child(1), other_body)
+	
+	var collision_shape: SGCollisionShape2D = bodies[0].get_child(0)
+	assert_eq(collision_shape.shape.extents.x, 1310720)
+	assert_eq(collision_shape.shape.extents.y, 1310720)
+	assert_eq(collision_shape.fixed_position.x, 655360)
+	assert_eq(collision_shape.fixed_position.y, 655360)
+	
+	# The merged body covers the whole area that the original bodies did.
+	var area = SGArea2D.new()
+	var area_shape = SGCollisionShape2D.new()
+	area_shape.shape = SGRectangleShape2D.new()
+	area_shape.shape.extents = SGFixed.vector2(SGFixed.from_int(1), SGFixed.from_int(1))
+	area.add_child(area_shape)
+	area.fixed_position = SGFixed.vector2(SGFixed.from_int(135), SGFixed.from_int(135))
+	parent.add_child(area)
+	var overlapping = area.get_overlapping_bodies()
+	assert_eq(overlapping.size(), 1)
+	assert_eq(overlapping[0], bodies[0])
+	
+	remove_child(parent)
+	parent.queue_free()
+
+func test_merge_static_bodies_with_other_children() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var body1 = create_static_body(110, 110, 10)
+	parent.add_child(body1)
+	var body2 = create_static_body(130, 110, 10)
+	parent.add_child(body2)
+	
+	# This one has a sprite, which would be lost if it was freed.
+	var decorated_body = create_static_body(150, 110, 10)
+	var sprite = Sprite.new()
+	decorated_body.add_child(sprite)
+	parent.add_child(decorated_body)
+	
+	var info = SGPhysics2DServer.merge_static_bodies([body1, body2, decorated_body])
+	assert_eq(info['shapes_before'], 2)
+	assert_eq(info['shapes_after'], 1)
+	
+	assert_eq(parent.get_child_count(), 2)
+	assert_eq(parent.get_child(0), body1)
+	assert_eq(parent.get_child(1), decorated_body)
+	assert_eq(sprite.get_parent(), decorated_body)
+	
+	remove_child(parent)
+	parent.queue_free()
+
+func test_cast_shape() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var body = create_static_body(100, 100, 10)
+	parent.add_child(body)
+	
+	var shape = SGRectangleShape2D.new()
+	shape.extents = SGFixed.vector2(SGFixed.from_int(5), SGFixed.from_int(5))
+	var transform = SGFixedTransform2D.new()
+	transform.origin = SGFixed.vector2(SGFixed.from_int(50), SGFixed.from_int(100))
+	var motion = SGFixed.vector2(SGFixed.from_int(100), 0)
+	
+	var result = SGPhysics2DServer.cast_shape(shape, transform, motion)
+	assert_eq(result['collider'], body)
+	# It touches after moving 35 of the 100 pixels.
+	assert_eq(result['fraction'], 22937)
+	assert_eq(result['point'].x, SGFixed.from_int(90))
+	assert_eq(result['normal'].x, -65536)
+	assert_eq(result['normal'].y, 0)
+	
+	# Nothing is hit when it's on another layer, or an exception.
+	assert_true(SGPhysics2DServer.cast_shape(shape, transform, motion, 2).empty())
+	assert_true(SGPhysics2DServer.cast_shape(shape, transform, motion, 1, [body]).empty())
+	
+	# Or when it stops short.
+	motion = SGFixed.vector2(SGFixed.from_int(30), 0)
+	assert_true(SGPhysics2DServer.cast_shape(shape, transform, motion).empty())
+	
+	# When it starts out overlapping, the point is on the collider's surface.
+	transform.origin = SGFixed.vector2(SGFixed.from_int(87), SGFixed.from_int(100))
+	result = SGPhysics2DServer.cast_shape(shape, transform, motion)
+	assert_eq(result['collider'], body)
+	assert_eq(result['fraction'], 0)
+	assert_eq(result['point'].x, SGFixed.from_int(90))
+	assert_eq(result['point'].y, SGFixed.from_int(100))
+	assert_eq(result['normal'].x, -65536)
+	
+	remove_child(parent)
+	parent.queue_free()
+
+func test_cast_shape_in_world() -> void:
+	var world = SGPhysics2DServer.world_create()
+	var body = SGPhysics2DServer.body_create(SGPhysics2DServer.BODY_STATIC, world)
+	SGPhysics2DServer.collision_object_add_rectangle_shape(body, SGFixed.from_int(10), SGFixed.from_int(10))
+	
+	var shape = SGRectangleShape2D.new()
+	shape.extents = SGFixed.vector2(SGFixed.from_int(5), SGFixed.from_int(5))
+	var transform = SGFixedTransform2D.new()
+	transform.origin = SGFixed.vector2(SGFixed.from_int(-50), 0)
+	var motion = SGFixed.vector2(SGFixed.from_int(100), 0)
+	
+	# The body is only in the created world, not the default one.
+	assert_true(SGPhysics2DServer.cast_shape(shape, transform, motion).empty())
+	var result = SGPhysics2DServer.cast_shape(shape, transform, motion, 1, [], world)
+	assert_eq(result['collider'], body)
+	assert_eq(result['point'].x, SGFixed.from_int(-10))
+	
+	# The same goes for the world of an SGWorld2D.
+	var world_node = SGWorld2D.new()
+	add_child(world_node)
+	var node_body = create_static_body(0, 0, 10)
+	world_node.add_child(node_body)
+	assert_eq(SGPhysics2DServer.cast_shape(shape, transform, motion, 1, [], world_node)['collider'], node_body)
+	assert_eq(SGPhysics2DServer.cast_shape(shape, transform, motion, 1, [], node_body)['collider'], node_body)
+	
+	SGPhysics2DServer.free_rid(body)
+	SGPhysics2DServer.free_rid(world)
+	remove_child(world_node)
+	world_node.queue_free()
+
+func test_move_and_slide_bodies() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	parent.add_child(create_static_body(100, 100, 10))
+	var bodies := [create_kinematic_body(50, 100, 5), create_kinematic_body(50, 200, 5)]
+	for body in bodies:
+		parent.add_child(body)
+	
+	var velocities := [SGFixed.from_int(100), 0, SGFixed.from_int(100), 0]
+	var result = SGPhysics2DServer.move_and_slide_bodies(bodies, velocities)
+	var positions: Array = result['positions']
+	var remaining: Array = result['velocities']
+	
+	# The second body doesn't hit anything.
+	assert_eq(positions[2], SGFixed.from_int(150))
+	assert_eq(positions[3], SGFixed.from_int(200))
+	assert_eq(remaining[2], 0)
+	assert_eq(remaining[3], 0)
+	assert_eq(bodies[1].fixed_position.x, positions[2])
+	assert_eq(bodies[1].fixed_position.y, positions[3])
+	
+	# The first one gets stopped by the wall, just like with move_and_slide().
+	var first_position = bodies[0].fixed_position.copy()
+	assert_eq(first_position.x, positions[0])
+	assert_eq(first_position.y, positions[1])
+	
+	bodies[0].fixed_position = SGFixed.vector2(SGFixed.from_int(50), SGFixed.from_int(100))
+	bodies[0].sync_to_physics_engine()
+	var remainder = bodies[0].move_and_slide(SGFixed.vector2(SGFixed.from_int(100), 0))
+	assert_eq(bodies[0].fixed_position.x, first_position.x)
+	assert_eq(bodies[0].fixed_position.y, first_position.y)
+	assert_eq(remainder.x, remaining[0])
+	assert_eq(remainder.y, remaining[1])
+	
+	remove_child(parent)
+	parent.queue_free()
+
+func test_move_and_slide_bodies_transformed_parent() -> void:
+	# Converting to the parent's local coordinates rounds, so this makes sure
+	# the results match move_and_slide() exactly, not just approximately.
+	var parent = SGFixedNode2D.new()
+	parent.fixed_rotation = 19661
+	parent.fixed_scale = SGFixed.vector2(98304, 81920)
+	add_child(parent)
+	
+	parent.add_child(create_static_body(40, 0, 10))
+	var bodies := [create_kinematic_body(0, 0, 5), create_kinematic_body(0, 30, 5)]
+	for body in bodies:
+		parent.add_child(body)
+	
+	var velocities := [SGFixed.from_int(100), SGFixed.from_int(30), SGFixed.from_int(100), SGFixed.from_int(-30)]
+	var result = SGPhysics2DServer.move_and_slide_bodies(bodies, velocities)
+	var positions: Array = result['positions']
+	var remaining: Array = result['velocities']
+	
+	var batch_positions := []
+	for body in bodies:
+		batch_positions.append(body.fixed_position.copy())
+	
+	bodies[0].fixed_position = SGFixed.vector2(0, 0)
+	bodies[1].fixed_position = SGFixed.vector2(0, SGFixed.from_int(30))
+	for i in range(bodies.size()):
+		bodies[i].sync_to_physics_engine()
+	
+	for i in range(bodies.size()):
+		var remainder = bodies[i].move_and_slide(SGFixed.vector2(velocities[i * 2], velocities[i * 2 + 1]))
+		assert_eq(bodies[i].fixed_position.x, batch_positions[i].x)
+		assert_eq(bodies[i].fixed_position.y, batch_positions[i].y)
+		assert_eq(bodies[i].get_global_fixed_position().x, positions[i * 2])
+		assert_eq(bodies[i].get_global_fixed_position().y, positions[i * 2 + 1])
+		assert_eq(remainder.x, remaining[i * 2])
+		assert_eq(remainder.y, remaining[i * 2 + 1])
+	
+	remove_child(parent)
+	parent.queue_free()
+
+func test_move_and_slide_bodies_far_away() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	# Fixed-point positions this far out don't fit in 32-bits.
+	var body = create_kinematic_body(39990, 100, 5)
+	parent.add_child(body)
+	
+	var result = SGPhysics2DServer.move_and_slide_bodies([body], [SGFixed.from_int(100), 0])
+	assert_eq(result['positions'][0], SGFixed.from_int(40090))
+	assert_eq(result['positions'][1], SGFixed.from_int(100))
+	assert_eq(result['velocities'], [0, 0])
+	assert_eq(body.fixed_position.x, SGFixed.from_int(40090))
+	
+	remove_child(parent)
+	parent.queue_free()
+
+func test_rid_collision_objects() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var static_body = create_static_body(100, 100, 10)
+	parent.add_child(static_body)
+	
+	var area = SGPhysics2DServer.area_create()
+	SGPhysics2DServer.collision_object_add_circle_shape(area, SGFixed.from_int(5))
+	SGPhysics2DServer.collision_object_set_position(area, SGFixed.from_int(112), SGFixed.from_int(100))
+	
+	var body = SGPhysics2DServer.body_create(SGPhysics2DServer.BODY_STATIC)
+	SGPhysics2DServer.collision_object_add_rectangle_shape(body, SGFixed.from_int(5), SGFixed.from_int(5))
+	SGPhysics2DServer.collision_object_set_position(body, SGFixed.from_int(120), SGFixed.from_int(100))
+	
+	# Nodes are returned as themselves, and server objects as their RID.
+	var result = SGPhysics2DServer.area_get_overlapping_bodies(area)
+	assert_eq(result.size(), 2)
+	assert_eq(result[0], static_body)
+	assert_eq(result[1], body)
+	
+	# Move them both away from the static body.
+	SGPhysics2DServer.collision_objects_set_positions([area, body], [
+		SGFixed.from_int(212), SGFixed.from_int(100),
+		SGFixed.from_int(220), SGFixed.from_int(100),
+	])
+	result = SGPhysics2DServer.area_get_overlapping_bodies(area)
+	assert_eq(result, [body])
+	
+	# Nodes can see them too.
+	var ray_cast = SGRayCast2D.new()
+	ray_cast.fixed_position = SGFixed.vector2(SGFixed.from_int(200), SGFixed.from_int(100))
+	ray_cast.cast_to = SGFixed.vector2(SGFixed.from_int(60), 0)
+	parent.add_child(ray_cast)
+	ray_cast.update_raycast_collision()
+	assert_true(ray_cast.is_colliding())
+	assert_eq(ray_cast.get_collider(), null)
+	assert_eq(ray_cast.get_collision_point().x, SGFixed.from_int(215))
+	
+	# Positions that don't fit in 32-bits still work.
+	SGPhysics2DServer.collision_objects_set_positions([area, body], [
+		SGFixed.from_int(40012), SGFixed.from_int(100),
+		SGFixed.from_int(40020), SGFixed.from_int(100),
+	])
+	result = SGPhysics2DServer.area_get_overlapping_bodies(area)
+	assert_eq(result, [body])
+	ray_cast.fixed_position = SGFixed.vector2(SGFixed.from_int(40000), SGFixed.from_int(100))
+	ray_cast.update_raycast_collision()
+	assert_eq(ray_cast.get_collision_point().x, SGFixed.from_int(40015))
+	
+	SGPhysics2DServer.free_rid(body)
+	result = SGPhysics2DServer.area_get_overlapping_bodies(area)
+	assert_eq(result.size(), 0)
+	SGPhysics2DServer.free_rid(area)
+	
+	remove_child(parent)
+	parent.queue_free()
+
+func test_kinematic_collision_with_rid_body() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var kinematic_body = create_kinematic_body(100, 100, 5)
+	parent.add_child(kinematic_body)
+	
+	var body = SGPhysics2DServer.body_create(SGPhysics2DServer.BODY_STATIC)
+	SGPhysics2DServer.collision_object_add_rectangle_shape(body, SGFixed.from_int(5), SGFixed.from_int(5))
+	SGPhysics2DServer.collision_object_set_position(body, SGFixed.from_int(130), SGFixed.from_int(100))
+	
+	# Server objects have no node, so they can only be told apart by RID.
+	var collision = kinematic_body.move_and_collide(SGFixed.vector2(SGFixed.from_int(50), 0))
+	assert_not_null(collision)
+	assert_eq(collision.collider, null)
+	assert_eq(collision.collider_rid, body)
+	
+	# Nodes don't have an RID.
+	var static_body = create_static_body(100, 130, 5)
+	parent.add_child(static_body)
+	collision = kinematic_body.move_and_collide(SGFixed.vector2(SGFixed.from_int(-20), SGFixed.from_int(50)))
+	assert_not_null(collision)
+	assert_eq(collision.collider, static_body)
+	assert_eq(collision.collider_rid, RID())
+	
+	SGPhysics2DServer.free_rid(body)
+	remove_child(parent)
+	parent.queue_free()
+
+func test_worlds_step() -> void:
+	var world1 = SGPhysics2DServer.world_create()
+	var world2 = SGPhysics2DServer.world_create()
+	
+	var body1 = SGPhysics2DServer.body_create(SGPhysics2DServer.BODY_STATIC, world1)
+	SGPhysics2DServer.collision_object_add_rectangle_shape(body1, SGFixed.from_int(10), SGFixed.from_int(10))
+	var body2 = SGPhysics2DServer.body_create(SGPhysics2DServer.BODY_STATIC, world2)
+	SGPhysics2DServer.collision_object_add_rectangle_shape(body2, SGFixed.from_int(10), SGFixed.from_int(10))
+	
+	# The same ray is cast in both worlds.
+	for world in [world1, world2]:
+		SGPhysics2DServer.world_set_ray_casts(world,
+			[0, SGFixed.from_int(-60)],
+			[0, SGFixed.from_int(100)])
+	
+	# Only body2 is moved out of the way, and not until the step.
+	SGPhysics2DServer.world_queue_positions(world2, [body2], [SGFixed.from_int(100), 0])
+	assert_eq(SGPhysics2DServer.world_get_ray_results(world1)["colliders"], [])
+	
+	SGPhysics2DServer.worlds_step([world1, world2])
+	
+	var result = SGPhysics2DServer.world_get_ray_results(world1)
+	assert_eq(result["colliders"], [body1])
+	assert_eq(result["points"], [0, SGFixed.from_int(-10)])
+	assert_eq(result["normals"], [0, -SGFixed.ONE])
+	
+	result = SGPhysics2DServer.world_get_ray_results(world2)
+	assert_eq(result["colliders"], [null])
+	
+	# A body that's freed after the step is no longer reported, but the rest
+	# of its result is.
+	SGPhysics2DServer.free_rid(body1)
+	result = SGPhysics2DServer.world_get_ray_results(world1)
+	assert_eq(result["colliders"], [null])
+	assert_eq(result["points"], [0, SGFixed.from_int(-10)])
+	
+	# Objects have to be freed before the world they're in.
+	SGPhysics2DServer.free_rid(body2)
+	SGPhysics2DServer.free_rid(world1)
+	SGPhysics2DServer.free_rid(world2)
+
+func test_worlds_step_motions_and_areas() -> void:
+	var world = SGPhysics2DServer.world_create()
+	
+	var wall = SGPhysics2DServer.body_create(SGPhysics2DServer.BODY_STATIC, world)
+	SGPhysics2DServer.collision_object_add_rectangle_shape(wall, SGFixed.from_int(10), SGFixed.from_int(10))
+	SGPhysics2DServer.collision_objects_set_positions([wall], [SGFixed.from_int(100), 0])
+	
+	var body = SGPhysics2DServer.body_create(SGPhysics2DServer.BODY_KINEMATIC, world)
+	SGPhysics2DServer.collision_object_add_rectangle_shape(body, SGFixed.from_int(5), SGFixed.from_int(5))
+	
+	var near_area = SGPhysics2DServer.area_create(world)
+	SGPhysics2DServer.collision_object_add_rectangle_shape(near_area, SGFixed.from_int(5), SGFixed.from_int(5))
+	var far_area = SGPhysics2DServer.area_create(world)
+	SGPhysics2DServer.collision_object_add_rectangle_shape(far_area, SGFixed.from_int(5), SGFixed.from_int(5))
+	SGPhysics2DServer.collision_objects_set_positions([near_area, far_area], [SGFixed.from_int(85), 0, SGFixed.from_int(-50), 0])
+	SGPhysics2DServer.world_set_monitored_areas(world, [near_area, far_area])
+	
+	# The body is stopped by the wall, and ends up inside the near area.
+	SGPhysics2DServer.world_queue_motions(world, [body], [SGFixed.from_int(95), 0])
+	SGPhysics2DServer.worlds_step([world])
+	
+	var result = SGPhysics2DServer.world_get_motion_results(world)
+	assert_eq(result["bodies"], [body])
+	assert_gt(result["positions"][0], SGFixed.from_int(84))
+	assert_lt(result["positions"][0], SGFixed.from_int(86))
+	assert_eq(result["positions"][1], 0)
+	assert_eq(result["remainders"], [0, 0])
+	
+	var overlaps = SGPhysics2DServer.world_get_area_overlaps(world)
+	assert_eq(overlaps[near_area], [body])
+	assert_eq(overlaps[far_area], [])
+	
+	# Motions are only applied once.
+	SGPhysics2DServer.worlds_step([world])
+	assert_eq(SGPhysics2DServer.world_get_motion_results(world)["bodies"], [])
+	
+	SGPhysics2DServer.free_rid(wall)
+	SGPhysics2DServer.free_rid(body)
+	SGPhysics2DServer.free_rid(near_area)
+	SGPhysics2DServer.free_rid(far_area)
+	SGPhysics2DServer.free_rid(world)
+
+func test_process_info_from_all_worlds() -> void:
+	var world = SGPhysics2DServer.world_create()
+	var area = SGPhysics2DServer.area_create(world)
+	SGPhysics2DServer.collision_object_add_rectangle_shape(area, SGFixed.from_int(10), SGFixed.from_int(10))
+	var body = SGPhysics2DServer.body_create(SGPhysics2DServer.BODY_STATIC, world)
+	SGPhysics2DServer.collision_object_add_rectangle_shape(body, SGFixed.from_int(10), SGFixed.from_int(10))
+	
+	# Only the created world is used, but it's still counted.
+	SGPhysics2DServer.reset_process_info()
+	assert_eq(SGPhysics2DServer.area_get_overlapping_bodies(area), [body])
+	assert_gt(SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_PREFILTER_TESTS), 0)
+	
+	SGPhysics2DServer.reset_process_info()
+	assert_eq(SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_PREFILTER_TESTS), 0)
+	
+	SGPhysics2DServer.free_rid(area)
+	SGPhysics2DServer.free_rid(body)
+	SGPhysics2DServer.free_rid(world)
@@ -0,0 +1,45 @@
+extends "res://addons/gut/test.gd"
+
+func create_static_body(x: int, y: int, extents: int) -> SGStaticBody2D:
+	var body = SGStaticBody2D.new()
+	body.fixed_position = SGFixed.vector2(SGFixed.from_int(x), SGFixed.from_int(y))
+	var collision_shape = SGCollisionShape2D.new()
+	var shape = SGRectangleShape2D.new()
+	shape.extents = SGFixed.vector2(SGFixed.from_int(extents), SGFixed.from_int(extents))
+	collision_shape.shape = shape
+	body.add_child(collision_shape)
+	return body
+
+func test_update_raycast_collisions() -> void:
+	var parent = Node2D.new()
+	add_child(parent)
+	
+	var body = create_static_body(0, 100, 10)
+	parent.add_child(body)
+	
+	var ray_fan = SGRayFan2D.new()
+	ray_fan.cast_to = SGFixed.vector2(0, SGFixed.from_int(180))
+	ray_fan.spread = SGFixed.PI_DIV_4 * 2
+	ray_fan.ray_count = 3
+	parent.add_child(ray_fan)
+	
+	ray_fan.update_raycast_collisions()
+	
+	# Only the middle ray hits the body.
+	assert_false(ray_fan.is_ray_colliding(0))
+	assert_eq(ray_fan.get_ray_collider(0), null)
+	assert_true(ray_fan.is_ray_colliding(1))
+	assert_eq(ray_fan.get_ray_collider(1), body)
+	assert_eq(ray_fan.get_ray_collision_point(1).x, 0)
+	assert_eq(ray_fan.get_ray_collision_point(1).y, SGFixed.from_int(90))
+	assert_eq(ray_fan.get_ray_collision_normal(1).x, 0)
+	assert_eq(ray_fan.get_ray_collision_normal(1).y, -SGFixed.ONE)
+	assert_false(ray_fan.is_ray_colliding(2))
+	
+	# Exceptions are ignored by every ray.
+	ray_fan.add_exception(body)
+	ray_fan.update_raycast_collisions()
+	assert_false(ray_fan.is_ray_colliding(1))
+	
+	remove_child(parent)
+	parent.queue_free()
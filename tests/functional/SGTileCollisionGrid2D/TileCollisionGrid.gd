@@ -0,0 +1,18 @@
+extends Node2D
+
+onready var tile_grid: SGTileCollisionGrid2D = $TileGrid
+onready var kinematic_body: SGKinematicBody2D = $KinematicBody
+onready var ray_cast: SGRayCast2D = $RayCast
+onready var start_transform: SGFixedTransform2D = kinematic_body.fixed_transform.copy()
+
+func reset_kinematic_body() -> void:
+	kinematic_body.fixed_transform = start_transform
+	kinematic_body.sync_to_physics_engine()
+
+func do_move_and_collide() -> SGKinematicCollision2D:
+	var vector = SGFixed.vector2(0, -SGFixed.TWO)
+	return kinematic_body.move_and_collide(vector)
+
+func _on_Button_pressed() -> void:
+	reset_kinematic_body()
+	do_move_and_collide()
@@ -0,0 +1,69 @@
+extends "res://addons/gut/test.gd"
+
+func test_tile_data() -> void:
+	var TileCollisionGrid = load("res://tests/functional/SGTileCollisionGrid2D/TileCollisionGrid.tscn")
+	var scene = TileCollisionGrid.instance()
+	add_child(scene)
+	
+	var tile_grid: SGTileCollisionGrid2D = scene.tile_grid
+	assert_true(tile_grid.is_cell_solid(0, 0))
+	assert_true(tile_grid.is_cell_solid(1, 0))
+	assert_false(tile_grid.is_cell_solid(2, 0))
+	assert_false(tile_grid.is_cell_solid(0, 1))
+	assert_false(tile_grid.is_cell_solid(-1, 0))
+	assert_false(tile_grid.is_cell_solid(4, 0))
+	
+	# Resizing keeps the cells that are still in the grid.
+	tile_grid.grid_width = 1
+	assert_true(tile_grid.is_cell_solid(0, 0))
+	assert_false(tile_grid.is_cell_solid(1, 0))
+	
+	assert_eq(tile_grid.world_to_map(SGFixed.vector2(1376256, 655360)), Vector2(1, 0))
+	assert_eq(tile_grid.world_to_map(SGFixed.vector2(-1, 0)), Vector2(-1, 0))
+	var position = tile_grid.map_to_world(2, 1)
+	assert_eq(position.x, 2621440)
+	assert_eq(position.y, 1310720)
+	
+	remove_child(scene)
+	scene.queue_free()
+
+func test_move_and_collide() -> void:
+	var TileCollisionGrid = load("res://tests/functional/SGTileCollisionGrid2D/TileCollisionGrid.tscn")
+	
+	# Run 5 times to attempt to check if this is deterministic.
+	for i in range(5):
+		var scene = TileCollisionGrid.instance()
+		add_child(scene)
+		
+		var collision: SGKinematicCollision2D = scene.do_move_and_collide()
+		assert_not_null(collision)
+		assert_eq(collision.collider, scene.tile_grid)
+		assert_eq(collision.normal.x, 0)
+		assert_eq(collision.normal.y, 65536)
+		assert_eq(scene.kinematic_body.fixed_transform.origin.x, 1310720)
+		assert_eq(scene.kinematic_body.fixed_transform.origin.y, 1966080)
+		assert_eq(collision.remainder.x, 0)
+		assert_eq(collision.remainder.y, -65536)
+		
+		remove_child(scene)
+		scene.queue_free()
+
+func test_ray_cast() -> void:
+	var TileCollisionGrid = load("res://tests/functional/SGTileCollisionGrid2D/TileCollisionGrid.tscn")
+	var scene = TileCollisionGrid.instance()
+	add_child(scene)
+	
+	var ray_cast: SGRayCast2D = scene.ray_cast
+	ray_cast.update_raycast_collision()
+	assert_true(ray_cast.is_colliding())
+	assert_eq(ray_cast.get_collider(), scene.tile_grid)
+	assert_eq(ray_cast.get_collision_point().x, 2621520)
+	assert_eq(ray_cast.get_collision_point().y, 655360)
+	
+	# With the cells cleared, there's nothing to hit.
+	scene.tile_grid.clear()
+	ray_cast.update_raycast_collision()
+	assert_false(ray_cast.is_colliding())
+	
+	remove_child(scene)
+	scene.queue_free()
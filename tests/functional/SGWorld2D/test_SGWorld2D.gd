@@ -0,0 +1,101 @@
+extends "res://addons/gut/test.gd"
+
+func create_static_body(x: int, y: int, extents: int) -> SGStaticBody2D:
+	var body = SGStaticBody2D.new()
+	body.fixed_position = SGFixed.vector2(SGFixed.from_int(x), SGFixed.from_int(y))
+	var collision_shape = SGCollisionShape2D.new()
+	var shape = SGRectangleShape2D.new()
+	shape.extents = SGFixed.vector2(SGFixed.from_int(extents), SGFixed.from_int(extents))
+	collision_shape.shape = shape
+	body.add_child(collision_shape)
+	return body
+
+func create_area(x: int, y: int, extents: int) -> SGArea2D:
+	var area = SGArea2D.new()
+	area.fixed_position = SGFixed.vector2(SGFixed.from_int(x), SGFixed.from_int(y))
+	var collision_shape = SGCollisionShape2D.new()
+	var shape = SGRectangleShape2D.new()
+	shape.extents = SGFixed.vector2(SGFixed.from_int(extents), SGFixed.from_int(extents))
+	collision_shape.shape = shape
+	area.add_child(collision_shape)
+	return area
+
+func test_separate_worlds() -> void:
+	var world1 = SGWorld2D.new()
+	add_child(world1)
+	var world2 = SGWorld2D.new()
+	add_child(world2)
+	
+	# Everything is in the same place, but split across the two worlds and
+	# the default one.
+	var area1 = create_area(0, 0, 10)
+	world1.add_child(area1)
+	var body1 = create_static_body(0, 0, 10)
+	world1.add_child(body1)
+	
+	var area2 = create_area(0, 0, 10)
+	world2.add_child(area2)
+	var body2 = create_static_body(0, 0, 10)
+	world2.add_child(body2)
+	
+	var default_body = create_static_body(0, 0, 10)
+	add_child(default_body)
+	
+	SGPhysics2DServer.sync_all_dirty()
+	
+	assert_eq(area1.get_overlapping_bodies(), [body1])
+	assert_eq(area2.get_overlapping_bodies(), [body2])
+	assert_eq(area1.get_overlapping_areas(), [])
+	
+	# Ray casts use the world of their nearest SGWorld2D ancestor too.
+	var ray_cast = SGRayCast2D.new()
+	ray_cast.fixed_position = SGFixed.vector2(0, SGFixed.from_int(-60))
+	ray_cast.cast_to = SGFixed.vector2(0, SGFixed.from_int(60))
+	world2.add_child(ray_cast)
+	ray_cast.update_raycast_collision()
+	assert_eq(ray_cast.get_collider(), body2)
+	
+	# Moving a body into the other world moves it in the physics engine.
+	world1.remove_child(body1)
+	world2.add_child(body1)
+	SGPhysics2DServer.sync_all_dirty()
+	assert_eq(area1.get_overlapping_bodies(), [])
+	assert_eq(area2.get_overlapping_bodies().size(), 2)
+	
+	remove_child(default_body)
+	default_body.queue_free()
+	remove_child(world1)
+	world1.queue_free()
+	remove_child(world2)
+	world2.queue_free()
+
+func test_viewport_worlds() -> void:
+	var viewport = Viewport.new()
+	add_child(viewport)
+	# Set before it enters the tree, since Godot won't allow it afterwards.
+	var shared_viewport = Viewport.new()
+	shared_viewport.world_2d = get_viewport().world_2d
+	add_child(shared_viewport)
+	
+	var area = create_area(0, 0, 10)
+	add_child(area)
+	var viewport_area = create_area(0, 0, 10)
+	viewport.add_child(viewport_area)
+	var viewport_body = create_static_body(0, 0, 10)
+	viewport.add_child(viewport_body)
+	var shared_body = create_static_body(0, 0, 10)
+	shared_viewport.add_child(shared_body)
+	
+	SGPhysics2DServer.sync_all_dirty()
+	
+	# A viewport with its own World2D has its own world, but one that shares
+	# the root viewport's World2D uses the default world.
+	assert_eq(area.get_overlapping_bodies(), [shared_body])
+	assert_eq(viewport_area.get_overlapping_bodies(), [viewport_body])
+	
+	remove_child(area)
+	area.queue_free()
+	remove_child(viewport)
+	viewport.queue_free()
+	remove_child(shared_viewport)
+	shared_viewport.queue_free()
@@ -20,3 +20,74 @@ func test_initial_scale():
 	assert_eq(n.fixed_transform.x.y, 0)
 	assert_eq(n.fixed_transform.y.x, 0)
 	assert_eq(n.fixed_transform.y.y, 65536)
+
+func test_float_transform_sync():
+	var n = SGFixedNode2D.new()
+	add_child(n)
+	
+	SGPhysics2DServer.flush_float_transforms()
+	SGPhysics2DServer.reset_process_info()
+	
+	# Nothing changed, so nothing should be synced.
+	SGPhysics2DServer.flush_float_transforms()
+	assert_eq(SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_FLOAT_TRANSFORM_SYNCS), 0)
+	
+	# The float transform isn't updated until the flush.
+	n.fixed_position = SGFixed.vector2(SGFixed.from_int(10), SGFixed.from_int(20))
+	assert_eq(n.position, Vector2.ZERO)
+	SGPhysics2DServer.flush_float_transforms()
+	assert_eq(n.position, Vector2(10, 20))
+	assert_eq(SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_FLOAT_TRANSFORM_SYNCS), 1)
+	
+	# Changing it twice should still only sync once.
+	n.fixed_position.x = SGFixed.from_int(30)
+	n.fixed_rotation = SGFixed.PI_DIV_4
+	SGPhysics2DServer.flush_float_transforms()
+	assert_eq(n.position, Vector2(30, 20))
+	assert_eq(SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_FLOAT_TRANSFORM_SYNCS), 2)
+	
+	# Nodes that aren't in the tree are synced when they enter it.
+	remove_child(n)
+	n.fixed_position.y = SGFixed.from_int(40)
+	SGPhysics2DServer.flush_float_transforms()
+	assert_eq(n.position, Vector2(30, 20))
+	add_child(n)
+	SGPhysics2DServer.flush_float_transforms()
+	assert_eq(n.position, Vector2(30, 40))
+	
+	remove_child(n)
+	n.free()
+
+func test_global_fixed_transform_cache():
+	var parent = SGFixedNode2D.new()
+	var child = SGFixedNode2D.new()
+	var grandchild = SGFixedNode2D.new()
+	parent.add_child(child)
+	child.add_child(grandchild)
+	
+	child.fixed_position = SGFixed.vector2(SGFixed.from_int(10), 0)
+	grandchild.fixed_position = SGFixed.vector2(0, SGFixed.from_int(5))
+	assert_eq(grandchild.get_global_fixed_position().x, SGFixed.from_int(10))
+	assert_eq(grandchild.get_global_fixed_position().y, SGFixed.from_int(5))
+	
+	# Moving an ancestor should invalidate the cached global transform.
+	parent.fixed_position = SGFixed.vector2(SGFixed.from_int(100), SGFixed.from_int(200))
+	assert_eq(grandchild.get_global_fixed_position().x, SGFixed.from_int(110))
+	assert_eq(grandchild.get_global_fixed_position().y, SGFixed.from_int(205))
+	
+	# So should changing the axes directly.
+	parent.fixed_transform.x.x = SGFixed.TWO
+	assert_eq(grandchild.get_global_fixed_position().x, SGFixed.from_int(120))
+	
+	# And setting the global position should use the new parent transform.
+	grandchild.set_global_fixed_position(SGFixed.vector2(SGFixed.from_int(130), SGFixed.from_int(205)))
+	assert_eq(grandchild.fixed_position.x, SGFixed.from_int(5))
+	assert_eq(grandchild.fixed_position.y, SGFixed.from_int(5))
+	
+	# Reparenting should too.
+	child.remove_child(grandchild)
+	assert_eq(grandchild.get_global_fixed_position().x, SGFixed.from_int(5))
+	parent.add_child(grandchild)
+	assert_eq(grandchild.get_global_fixed_position().x, SGFixed.from_int(110))
+	
+	parent.free()
@@ -39,3 +39,62 @@ func test_normalize():
 	assert_eq(v.y, 65536)
 	assert_eq(v.length(), 65536)
 
+
+func test_normalize_matches_division():
+	# normalized() avoids dividing by the length twice, but it must still give
+	# exactly the same result as doing so.
+	var rng = RandomNumberGenerator.new()
+	rng.seed = 4321
+	var mismatches := []
+	for i in range(5000):
+		var bits = 8 + (i % 23)
+		var x = rng.randi() & ((1 << bits) - 1)
+		var y = rng.randi() & ((1 << bits) - 1)
+		if i % 2:
+			x = -x
+		if i % 3:
+			y = -y
+		if abs(x) < 256 or abs(y) < 256:
+			continue
+		var v = SGFixed.vector2(x, y)
+		var length = v.length()
+		var n = v.normalized()
+		if n.x != SGFixed.div(x, length) or n.y != SGFixed.div(y, length):
+			mismatches.append([x, y])
+	assert_eq(mismatches, [])
+
+func test_in_place_methods():
+	var v := SGFixed.vector2(65536, 131072)
+	
+	v.iadd_xy(65536, -65536)
+	assert_eq(v.x, 131072)
+	assert_eq(v.y, 65536)
+	
+	v.isub_xy(131072, 0)
+	assert_eq(v.x, 0)
+	assert_eq(v.y, 65536)
+	
+	v.set_xy(65536, 65536)
+	var n = v.normalized()
+	v.normalize()
+	assert_eq(v.x, n.x)
+	assert_eq(v.y, n.y)
+	
+	v.set_xy(65536, -65536)
+	var normal = SGFixed.vector2(0, 65536)
+	var slid = v.slide(normal)
+	v.islide(normal)
+	assert_eq(v.x, slid.x)
+	assert_eq(v.y, slid.y)
+
+func test_allocation_count():
+	var v := SGFixed.vector2(65536, 65536)
+	
+	SGPhysics2DServer.reset_process_info()
+	v.iadd_xy(65536, 0)
+	v.normalize()
+	assert_eq(SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_FIXED_VECTOR2_ALLOCATIONS), 0)
+	
+	v.add(v)
+	v.normalized()
+	assert_eq(SGPhysics2DServer.get_process_info(SGPhysics2DServer.INFO_FIXED_VECTOR2_ALLOCATIONS), 2)
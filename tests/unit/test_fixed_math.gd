@@ -30,6 +30,60 @@ func test_division():
 	
 	assert_eq(c, 491520)
 
+func test_large_multiplication_and_division():
+	# The intermediate results here don't fit in 64-bits.
+	var a: int = SGFixed.from_int(100000)
+	var b: int = SGFixed.from_int(300000)
+	assert_eq(SGFixed.mul(a, b), SGFixed.from_int(30000000000))
+	assert_eq(SGFixed.div(SGFixed.from_int(30000000000), b), a)
+	assert_eq(SGFixed.muldiv(a, b, SGFixed.from_int(1000)), SGFixed.from_int(30000000))
+	assert_eq(SGFixed.muldiv(SGFixed.from_float(2.5), SGFixed.from_float(2.5), SGFixed.from_int(2)), 204800)
+
+# The digit-by-digit square root that sg_sqrt_64() originally used, which
+# the current implementation must match exactly.
+func _reference_sqrt_64(num: int) -> int:
+	if num == 0:
+		return 0
+	var neg = num < 0
+	if neg:
+		num = -num
+	var res := 0
+	var bit := 1 << 62
+	while bit > num:
+		bit >>= 2
+	while bit != 0:
+		if num >= res + bit:
+			num -= res + bit
+			res = (res >> 1) + bit
+		else:
+			res >>= 1
+		bit >>= 2
+	return -res if neg else res
+
+func test_sqrt():
+	assert_eq(SGFixed.sqrt(SGFixed.from_int(4)), SGFixed.from_int(2))
+	assert_eq(SGFixed.sqrt(SGFixed.from_int(-9)), SGFixed.from_int(-3))
+	assert_eq(SGFixed.sqrt(2*65536), 92681)
+	
+	var mismatches := []
+	
+	# Every small value.
+	for i in range(-20000, 20000):
+		if SGFixed.sqrt(i) != _reference_sqrt_64(i << 16):
+			mismatches.append(i)
+	
+	# Random values of every size (values need to stay below 2^47, so they
+	# can be shifted up to 32 fractional bits).
+	var rng = RandomNumberGenerator.new()
+	rng.seed = 12345
+	for i in range(20000):
+		var bits = 1 + (i % 46)
+		var value = ((rng.randi() << 32) | rng.randi()) & ((1 << bits) - 1)
+		if SGFixed.sqrt(value) != _reference_sqrt_64(value << 16):
+			mismatches.append(value)
+	
+	assert_eq(mismatches, [])
+
 func test_trig():
 	#
 	# Test some important "well known" values
@@ -38,17 +92,21 @@ func test_trig():
 	var sin_0: int = SGFixed.sin(0)
 	assert_eq(sin_0, 0)
 	
-	# This should match cos(0), but it doesn't since we're temporarily
-	# hard-coding it.
-	#
-	# @todo Remove after we've replaced libfixmatch per issue #4:
-	#       https://gitlab.com/snopek-games/sg-physics-2d/-/issues/4
-	#var sin_90deg: int = SGFixed.sin(SGFixed.PI / 2)
-	#assert_eq(sin_90deg, 65536)
+	var sin_90deg: int = SGFixed.sin(SGFixed.PI / 2)
+	assert_eq(sin_90deg, 65536)
 	
 	var cos_0: int = SGFixed.cos(0)
 	assert_eq(cos_0, 65536)
 	
+	var asin_half: int = SGFixed.asin(SGFixed.HALF)
+	assert_eq(asin_half, 34315)
+	
+	var acos_half: int = SGFixed.acos(SGFixed.HALF)
+	assert_eq(acos_half, 68629)
+	
+	var atan2_180deg: int = SGFixed.atan2(0, -65536)
+	assert_eq(atan2_180deg, SGFixed.PI)
+	
 	#
 	# Test that big values loop around as expected
 	#
@@ -57,41 +115,71 @@ func test_trig():
 	assert_eq(sin_10, -35653)
 	
 	var sin_50000: int = SGFixed.sin(50000*65536)
-	assert_eq(sin_50000, -65309)
+	assert_eq(sin_50000, -65526)
 
 	var cos_10: int = SGFixed.cos(10*65536)
-	assert_eq(cos_10, -54990)
-
-#	var cos_50000: int = SGFixed.cos(50000*65536)
-#	assert_eq(cos_50000, 1000)
-#
-#	var tan_10: int = SGFixed.tan(10*65536)
-#	assert_eq(tan_10, 1000)
-#
-#	var tan_50000: int = SGFixed.tan(50000*65536)
-#	assert_eq(tan_50000, 1000)
-#
-#	var asin_10: int = SGFixed.asin(10*65536)
-#	assert_eq(asin_10, -35653)
-#
-#	var asin_50000: int = SGFixed.asin(50000*65536)
-#	assert_eq(asin_50000, -65309)
-#
-#	var acos_10: int = SGFixed.acos(10*65536)
-#	assert_eq(acos_10, 1000)
-#
-#	var acos_50000: int = SGFixed.acos(50000*65536)
-#	assert_eq(acos_50000, 1000)
-#
-#	var atan_10: int = SGFixed.atan(10*65536)
-#	assert_eq(atan_10, 1000)
-#
-#	var atan_50000: int = SGFixed.atan(50000*65536)
-#	assert_eq(atan_50000, 1000)
-#
-#	var atan2_10: int = SGFixed.atan2(10*65536, 2*65536)
-#	assert_eq(atan2_10, 1000)
-#
-#	var atan2_50000: int = SGFixed.atan2(50000*65536, 2*65536)
-#	assert_eq(atan2_50000, 1000)
+	assert_eq(cos_10, -54989)
+
+	var cos_50000: int = SGFixed.cos(50000*65536)
+	assert_eq(cos_50000, -1172)
 
+	var tan_10: int = SGFixed.tan(10*65536)
+	assert_eq(tan_10, 42491)
+
+	var tan_50000: int = SGFixed.tan(50000*65536)
+	assert_eq(tan_50000, 3665301)
+
+	var atan_10: int = SGFixed.atan(10*65536)
+	assert_eq(atan_10, 96412)
+
+	var atan_50000: int = SGFixed.atan(50000*65536)
+	assert_eq(atan_50000, 102942)
+
+	var atan2_10: int = SGFixed.atan2(10*65536, 2*65536)
+	assert_eq(atan2_10, 90007)
+
+	var atan2_50000: int = SGFixed.atan2(50000*65536, 2*65536)
+	assert_eq(atan2_50000, 102941)
+
+
+func test_array_math():
+	var a := PoolIntArray([65536, -98304, 32768, 13107200])
+	var b := PoolIntArray([131072, 65536, -196608, 327680])
+	
+	var mul_result = SGFixed.mul_array(a, b)
+	var div_result = SGFixed.div_array(a, b)
+	var add_result = SGFixed.add_array(a, b)
+	var sub_result = SGFixed.sub_array(a, b)
+	var sin_result = SGFixed.sin_array(a)
+	var cos_result = SGFixed.cos_array(a)
+	for i in range(a.size()):
+		assert_eq(mul_result[i], SGFixed.mul(a[i], b[i]))
+		assert_eq(div_result[i], SGFixed.div(a[i], b[i]))
+		assert_eq(add_result[i], a[i] + b[i])
+		assert_eq(sub_result[i], a[i] - b[i])
+		assert_eq(sin_result[i], SGFixed.sin(a[i]))
+		assert_eq(cos_result[i], SGFixed.cos(a[i]))
+	
+	# A single element is used for the whole array.
+	assert_eq(SGFixed.mul_array(a, PoolIntArray([SGFixed.TWO])), PoolIntArray([131072, -196608, 65536, 26214400]))
+
+func test_vector2_array_math():
+	var xy := PoolIntArray([65536, 0, 655360, -327680, -1, 300])
+	var rotations := PoolIntArray([SGFixed.PI_DIV_4, SGFixed.PI, -13107])
+	
+	var rotated = SGFixed.rotate_vector2_array(xy, rotations)
+	var normalized = SGFixed.normalize_vector2_array(xy)
+	for i in range(rotations.size()):
+		var v = SGFixed.vector2(xy[i * 2], xy[i * 2 + 1])
+		var r = v.rotated(rotations[i])
+		assert_eq(rotated[i * 2], r.x)
+		assert_eq(rotated[i * 2 + 1], r.y)
+		var n = v.normalized()
+		assert_eq(normalized[i * 2], n.x)
+		assert_eq(normalized[i * 2 + 1], n.y)
+	
+	rotated = SGFixed.rotate_vector2_array(xy, PoolIntArray([SGFixed.PI]))
+	for i in range(rotations.size()):
+		var r = SGFixed.vector2(xy[i * 2], xy[i * 2 + 1]).rotated(SGFixed.PI)
+		assert_eq(rotated[i * 2], r.x)
+		assert_eq(rotated[i * 2 + 1], r.y)